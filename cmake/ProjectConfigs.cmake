@@ -1,6 +1,7 @@
 list(APPEND CMAKE_MODULE_PATH "${CMAKE_CURRENT_LIST_DIR}/modules")
 
 include(AddSpdLog)
+include(AddThreads)
 include(AddEgl)
 include(AddX11)
 include(AddGlfw)
@@ -0,0 +1 @@
+find_package(Threads REQUIRED)
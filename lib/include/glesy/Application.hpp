@@ -0,0 +1,321 @@
+#pragma once
+
+#include "glesy/Api.h"
+#include "glesy/FrameMailbox.hpp"
+#include "glesy/FramePacer.hpp"
+#include "glesy/GpuTimer.hpp"
+#include "glesy/Window.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <optional>
+#include <thread>
+
+namespace glesy {
+
+struct ApplicationSettings {
+    WindowSettings window;
+    /** The number of fixed simulation steps per second */
+    double updateRate{60.0};
+    /** The limit of simulation steps per frame, the rest is dropped when the loop falls behind */
+    unsigned maxUpdatesPerFrame{5};
+    /** The frames per second limit (0 for the monitor refresh rate, negative for unlimited) */
+    double maxFrameRate{0.0};
+};
+
+/**
+ * Timing of the frame passed to @c Application::update
+ */
+struct FrameTime {
+    /** The fixed simulation step in seconds */
+    double step{};
+    /** The fraction of step elapsed since the last simulation step, to interpolate states */
+    double alpha{};
+    /** The time since previous frame in seconds */
+    double delta{};
+    /** The simulation time in seconds */
+    double time{};
+    std::uint64_t index{};
+};
+
+/**
+ * Per-frame timings in milliseconds
+ */
+struct FrameStats {
+    double frame{};
+    double update{};
+    double render{};
+    double gpu{};
+};
+
+/**
+ * Application runtime splitting event handling and rendering between two threads.
+ *
+ * The main thread polls window events, advances simulation with @c fixedUpdate at a fixed rate
+ * and runs @c update, which fills a frame packet, interpolating states between the last two
+ * simulation steps. The loop is paced by the frame rate cap (the monitor refresh rate by
+ * default). The render thread owns the OpenGL context and runs @c render with the latest
+ * published packet, so a blocking buffer swap (vsync) never delays input handling and vice
+ * versa. Packets are handed over through the triple-buffered @c FrameMailbox.
+ *
+ * OpenGL objects must be created in @c init and destroyed in @c shutdown, both called on the
+ * render thread while the context is current (e.g. keep them in std::optional members).
+ *
+ * @tparam Frame The frame packet type: everything render needs to know about the frame
+ */
+template<typename Frame>
+class Application {
+public:
+    /**
+     * @throw std::runtime_error if window creation fails
+     */
+    explicit Application(const ApplicationSettings& settings)
+        : _window{settings.window}
+        , _pacer{frameRateLimit(settings.maxFrameRate)}
+        , _step{1.0 / std::max(settings.updateRate, 1.0)}
+        , _maxUpdatesPerFrame{std::max(settings.maxUpdatesPerFrame, 1U)}
+        , _swapInterval{settings.window.swapInterval}
+    {
+        // Context is moved to the render thread in run()
+        Window::releaseCurrent();
+    }
+
+    Application(const Application&) = delete;
+
+    Application&
+    operator=(const Application&)
+        = delete;
+
+    virtual ~Application() = default;
+
+    /**
+     * Run main loop until window is closed (main thread)
+     * @return The process exit code
+     * @throw Rethrows exception escaped from render thread
+     */
+    int
+    run()
+    {
+        {
+            std::jthread renderer{[this] { renderLoop(); }};
+            try {
+                mainLoop();
+            } catch (...) {
+                // Release render thread waiting for packets, otherwise joining it never returns
+                _frames.close();
+                throw;
+            }
+            _frames.close();
+        }
+        if (_error) {
+            std::rethrow_exception(_error);
+        }
+        return EXIT_SUCCESS;
+    }
+
+    [[nodiscard]] Window&
+    window()
+    {
+        return _window;
+    }
+
+    /**
+     * Set frames per second limit, 0 for the monitor refresh rate, negative for unlimited
+     * (main thread)
+     */
+    void
+    setMaxFrameRate(const double maxFrameRate)
+    {
+        _pacer.setMaxFrameRate(frameRateLimit(maxFrameRate));
+    }
+
+    /**
+     * Set the number of screen updates to wait before swapping buffers (any thread)
+     */
+    void
+    setSwapInterval(const int interval)
+    {
+        _swapInterval.store(interval, std::memory_order_relaxed);
+    }
+
+    /**
+     * Get timings of the last frame (any thread). Render timings lag behind main thread ones.
+     */
+    [[nodiscard]] FrameStats
+    stats() const
+    {
+        return FrameStats{.frame = _frameMs.load(std::memory_order_relaxed),
+                          .update = _updateMs.load(std::memory_order_relaxed),
+                          .render = _renderMs.load(std::memory_order_relaxed),
+                          .gpu = _gpuMs.load(std::memory_order_relaxed)};
+    }
+
+    /**
+     * Get the number of frame packets replaced before being rendered
+     */
+    [[nodiscard]] std::size_t
+    droppedFrames() const
+    {
+        return _frames.dropped();
+    }
+
+protected:
+    /**
+     * Create OpenGL resources (render thread)
+     */
+    virtual void
+    init()
+    {
+    }
+
+    /**
+     * Advance simulation by one fixed step (main thread)
+     */
+    virtual void
+    fixedUpdate(double /*step*/)
+    {
+    }
+
+    /**
+     * Handle input and write frame packet (main thread)
+     */
+    virtual void
+    update(Frame& frame, const FrameTime& time)
+        = 0;
+
+    /**
+     * Draw frame packet, default framebuffer is bound and viewport is set (render thread)
+     */
+    virtual void
+    render(const Frame& frame)
+        = 0;
+
+    /**
+     * Destroy OpenGL resources (render thread)
+     */
+    virtual void
+    shutdown()
+    {
+    }
+
+private:
+    using Clock = FramePacer::Clock;
+
+    /**
+     * Main loop is paced even without explicit limit, simulating frames faster than they
+     * can be shown only burns CPU and drops packets
+     */
+    static double
+    frameRateLimit(const double maxFrameRate)
+    {
+        return (maxFrameRate == 0.0) ? Window::refreshRate() : maxFrameRate;
+    }
+
+    static double
+    milliseconds(const Clock::duration duration)
+    {
+        return std::chrono::duration<double, std::milli>{duration}.count();
+    }
+
+    void
+    mainLoop()
+    {
+        FrameTime time{.step = _step};
+        double accumulator{};
+        auto previous = Clock::now();
+        while (not _window.shouldClose() and not _failed.load(std::memory_order_acquire)) {
+            _pacer.wait();
+            const auto start = Clock::now();
+            time.delta = std::chrono::duration<double>{start - previous}.count();
+            _frameMs.store(milliseconds(start - previous), std::memory_order_relaxed);
+            previous = start;
+
+            glfwPollEvents();
+
+            accumulator += time.delta;
+            unsigned steps{};
+            while (accumulator >= _step and steps < _maxUpdatesPerFrame) {
+                fixedUpdate(_step);
+                accumulator -= _step;
+                time.time += _step;
+                steps++;
+            }
+            if (accumulator >= _step) {
+                // Simulation can't keep up, slow it down instead of spiralling
+                accumulator = std::fmod(accumulator, _step);
+            }
+            time.alpha = accumulator / _step;
+
+            update(_frames.back(), time);
+            _frames.publish();
+            time.index++;
+            _updateMs.store(milliseconds(Clock::now() - start), std::memory_order_relaxed);
+        }
+    }
+
+    void
+    renderLoop()
+    {
+        _window.makeCurrent();
+        try {
+            init();
+            std::optional<GpuTimer> gpuTimer{std::in_place};
+            int swapInterval = _swapInterval.load(std::memory_order_relaxed);
+            glfwSwapInterval(swapInterval);
+            int width{};
+            int height{};
+            while (_frames.wait()) {
+                if (const auto interval = _swapInterval.load(std::memory_order_relaxed);
+                    interval != swapInterval) {
+                    swapInterval = interval;
+                    glfwSwapInterval(swapInterval);
+                }
+                if (const auto [w, h] = _window.framebufferSize(); w != width or h != height) {
+                    width = w;
+                    height = h;
+                    glViewport(0, 0, width, height);
+                }
+
+                const auto start = Clock::now();
+                gpuTimer->begin();
+                render(_frames.front());
+                gpuTimer->end();
+                _renderMs.store(milliseconds(Clock::now() - start), std::memory_order_relaxed);
+                _gpuMs.store(gpuTimer->milliseconds(), std::memory_order_relaxed);
+
+                _window.swapBuffers();
+            }
+            gpuTimer.reset();
+            shutdown();
+        } catch (...) {
+            SPDLOG_ERROR("Render thread failed");
+            _error = std::current_exception();
+            _failed.store(true, std::memory_order_release);
+            glfwPostEmptyEvent();
+        }
+        Window::releaseCurrent();
+    }
+
+private:
+    Window _window;
+    FramePacer _pacer;
+    double _step{};
+    unsigned _maxUpdatesPerFrame{};
+    FrameMailbox<Frame> _frames;
+    std::atomic<int> _swapInterval{};
+    std::atomic<double> _frameMs{};
+    std::atomic<double> _updateMs{};
+    std::atomic<double> _renderMs{};
+    std::atomic<double> _gpuMs{};
+    std::atomic<bool> _failed{false};
+    std::exception_ptr _error;
+};
+
+} // namespace glesy
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <type_traits>
+
+namespace glesy {
+
+inline constexpr std::uint64_t kAssetHashSeed{0xcbf29ce484222325ULL};
+
+/**
+ * Hash bytes eight at a time with multiply-xorshift mixing (remaining tail bytes with FNV-1a)
+ * @param bytes The data to hash
+ * @param seed The hash of preceding data (allows hashing in pieces)
+ * @return The hash value
+ */
+[[nodiscard]] std::uint64_t
+hashBytes(std::span<const std::byte> bytes, std::uint64_t seed = kAssetHashSeed);
+
+template<typename T>
+    requires std::is_trivially_copyable_v<T>
+[[nodiscard]] std::uint64_t
+hashValue(const T& value, const std::uint64_t seed = kAssetHashSeed)
+{
+    return hashBytes(std::as_bytes(std::span{&value, 1}), seed);
+}
+
+/**
+ * Size and modification time of the file, cheap to compare on every load
+ */
+struct FileStamp {
+    std::filesystem::path path;
+    std::uint64_t size{};
+    /** The modification time in file clock ticks */
+    std::int64_t modified{};
+
+    /**
+     * Get current stamp of the file
+     * @throw std::filesystem::filesystem_error if file can't be queried
+     */
+    static FileStamp
+    of(const std::filesystem::path& path);
+
+    /**
+     * Check whether the file still exists with the same size and modification time
+     */
+    [[nodiscard]] bool
+    current() const;
+};
+
+/**
+ * Hash of source asset used to detect stale cooked data: covers content of every file the
+ * asset consists of together with cooker version and options
+ * @param files The source asset files (main file and files it references)
+ * @param cookerHash The hash of cooker version and options
+ * @return The asset hash
+ */
+[[nodiscard]] std::uint64_t
+assetHash(std::span<const std::filesystem::path> files, std::uint64_t cookerHash);
+
+} // namespace glesy
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "glesy/Api.h"
+
+#include <cstdint>
+#include <span>
+
+namespace glesy {
+
+/**
+ * Owns OpenGL buffer object. Storage is written through GL_COPY_WRITE_BUFFER target, so uploads
+ * never change bindings of the target (e.g. index buffer of the bound vertex array).
+ */
+class Buffer {
+public:
+    explicit Buffer(GLenum target);
+
+    Buffer(GLenum target, GLsizeiptr size, const void* data, GLenum usage = GL_STATIC_DRAW);
+
+    template<typename T, std::size_t N>
+    Buffer(GLenum target, std::span<T, N> data, GLenum usage = GL_STATIC_DRAW)
+        : Buffer{target, static_cast<GLsizeiptr>(data.size_bytes()), data.data(), usage}
+    {
+    }
+
+    Buffer(Buffer&& other) noexcept;
+
+    Buffer&
+    operator=(Buffer&& other) noexcept;
+
+    ~Buffer();
+
+    [[nodiscard]] GLuint
+    id() const;
+
+    /**
+     * Get process-wide unique buffer serial number. Unlike OpenGL names, serials are never
+     * reused after buffer is destroyed, so they are safe keys for caches outliving the buffer.
+     */
+    [[nodiscard]] std::uint64_t
+    serial() const;
+
+    [[nodiscard]] GLenum
+    target() const;
+
+    [[nodiscard]] GLsizeiptr
+    size() const;
+
+    void
+    bind() const;
+
+    /**
+     * Reallocate buffer storage
+     * @param size The new size of buffer in bytes
+     * @param data The data to copy into buffer (or @c nullptr to leave storage uninitialized)
+     * @param usage The expected usage pattern
+     */
+    void
+    setData(GLsizeiptr size, const void* data, GLenum usage = GL_STATIC_DRAW);
+
+    /**
+     * Update subset of buffer storage
+     * @param offset The offset in bytes into buffer storage
+     * @param size The size in bytes of data to update
+     * @param data The data to copy into buffer
+     */
+    void
+    setSubData(GLintptr offset, GLsizeiptr size, const void* data);
+
+    /**
+     * Copy range of another buffer storage into this buffer on GPU side
+     * @param source The buffer to copy from
+     * @param readOffset The offset in bytes into source buffer storage
+     * @param writeOffset The offset in bytes into this buffer storage
+     * @param size The size in bytes of data to copy
+     */
+    void
+    copySubData(const Buffer& source, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size);
+
+private:
+    GLuint _id{};
+    std::uint64_t _serial{};
+    GLenum _target{};
+    GLsizeiptr _size{};
+};
+
+} // namespace glesy
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "glesy/Parallel.hpp"
+#include "glesy/RenderQueue.hpp"
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace glesy {
+
+/**
+ * Draw commands recorded by single thread. Recording doesn't touch OpenGL, so it's safe on
+ * any thread; buffer memory is kept between frames.
+ */
+class CommandBuffer {
+public:
+    void
+    push(const RenderCommand& command);
+
+    void
+    reserve(std::size_t count);
+
+    void
+    clear();
+
+    [[nodiscard]] std::span<const RenderCommand>
+    commands() const;
+
+    [[nodiscard]] std::size_t
+    size() const;
+
+    [[nodiscard]] bool
+    empty() const;
+
+private:
+    std::vector<RenderCommand> _commands;
+};
+
+/**
+ * Per-thread command buffers filled in parallel (culling, LOD selection and uniform packing
+ * of many objects) and submitted into the render queue on the GL thread.
+ */
+class CommandRecorder {
+public:
+    /**
+     * @param buffers The number of command buffers (defaults to thread pool concurrency)
+     */
+    explicit CommandRecorder(std::size_t buffers = ThreadPool::instance().concurrency());
+
+    /**
+     * Split [0, count) range into contiguous chunks recorded in parallel by calling
+     * fn(buffer, begin, end), every chunk records into own command buffer
+     * @param count The number of items
+     * @param grain The minimum number of items in chunk
+     * @param fn The recording function
+     */
+    template<typename Fn>
+    void
+    record(const std::size_t count, const std::size_t grain, Fn&& fn)
+    {
+        if (count == 0) {
+            return;
+        }
+        const std::size_t chunks = std::clamp<std::size_t>(
+            (count + grain - 1) / std::max<std::size_t>(grain, 1), 1, _buffers.size());
+        const std::size_t chunkSize = (count + chunks - 1) / chunks;
+        ThreadPool::instance().run(chunks, [&](const std::size_t chunk) {
+            const std::size_t begin = chunk * chunkSize;
+            const std::size_t end = std::min(count, begin + chunkSize);
+            if (begin < end) {
+                fn(_buffers[chunk], begin, end);
+            }
+        });
+    }
+
+    /**
+     * Get command buffer for manual recording (one buffer per thread)
+     */
+    [[nodiscard]] CommandBuffer&
+    buffer(std::size_t index);
+
+    [[nodiscard]] std::size_t
+    bufferCount() const;
+
+    /**
+     * Append recorded commands to the queue in buffer order and clear buffers
+     * (must not overlap with recording)
+     * @param queue The render queue to sort and execute commands
+     */
+    void
+    submit(RenderQueue& queue);
+
+private:
+    std::vector<CommandBuffer> _buffers;
+};
+
+} // namespace glesy
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace glesy {
+
+/**
+ * Software depth rasterizer for CPU occlusion culling.
+ *
+ * A few large occluder meshes are rendered into a low resolution depth buffer split into tiles.
+ * Triangles are transformed, clipped against the near plane and binned to tiles on the calling
+ * thread, then tiles are rasterized in parallel four pixels at a time (SSE2, NEON or scalar)
+ * and reduced into a hierarchical max-depth buffer. Object bounds are tested against the
+ * hierarchy before anything is submitted to OpenGL, within the same frame.
+ *
+ * Depth follows OpenGL conventions: window depth in [0, 1] with less depth test. Tests are
+ * conservative for bounds crossing the near plane.
+ */
+class DepthRasterizer {
+public:
+    static constexpr int kTileSize{32};
+
+    struct Stats {
+        std::size_t occluders{};
+        std::size_t triangles{};
+        std::size_t binned{};
+        std::size_t tested{};
+        std::size_t occluded{};
+    };
+
+    /**
+     * @param width The buffer width in pixels (rounded up to tile size)
+     * @param height The buffer height in pixels (rounded up to tile size)
+     */
+    explicit DepthRasterizer(int width = 256, int height = 128);
+
+    [[nodiscard]] int
+    width() const;
+
+    [[nodiscard]] int
+    height() const;
+
+    /**
+     * Reset depth to far plane and drop binned occluders
+     */
+    void
+    clear();
+
+    /**
+     * Transform, clip and bin occluder triangles (front faces are counter-clockwise)
+     * @param vertices The occluder positions in object space
+     * @param indices The triangle list indices
+     * @param modelViewProjection The object to clip space matrix
+     */
+    void
+    addOccluder(std::span<const glm::vec3> vertices,
+                std::span<const std::uint32_t> indices,
+                const glm::mat4& modelViewProjection);
+
+    /**
+     * Rasterize binned occluders in parallel and build hierarchical depth
+     */
+    void
+    rasterize();
+
+    /**
+     * Check whether the box may be visible behind rasterized occluders
+     * @param minimum The box minimum corner in world space
+     * @param maximum The box maximum corner in world space
+     * @param viewProjection The view-projection matrix used for occluders
+     */
+    [[nodiscard]] bool
+    isVisible(const glm::vec3& minimum,
+              const glm::vec3& maximum,
+              const glm::mat4& viewProjection) const;
+
+    /**
+     * Remove occluded objects from the index list, testing in parallel
+     * @param minimums The box minimum corners of all objects
+     * @param maximums The box maximum corners of all objects
+     * @param viewProjection The view-projection matrix used for occluders
+     * @param indices The indices of tested objects, e.g. frustum culling output (order is kept)
+     * @return The number of remaining objects
+     */
+    std::size_t
+    filterVisible(std::span<const glm::vec3> minimums,
+                  std::span<const glm::vec3> maximums,
+                  const glm::mat4& viewProjection,
+                  std::vector<std::uint32_t>& indices);
+
+    /**
+     * Get full resolution depth, rows from bottom to top
+     */
+    [[nodiscard]] std::span<const float>
+    depth() const;
+
+    [[nodiscard]] const Stats&
+    stats() const;
+
+private:
+    /**
+     * Screen space triangle: edge functions (inside when all are non-negative) and depth plane
+     */
+    struct Triangle {
+        float edgeA[3];
+        float edgeB[3];
+        float edgeC[3];
+        float depth0{};
+        float depthX{};
+        float depthY{};
+        int minX{};
+        int minY{};
+        int maxX{};
+        int maxY{};
+    };
+
+    struct Level {
+        int width{};
+        int height{};
+        std::vector<float> depth;
+    };
+
+    void
+    addTriangle(const glm::vec4& v0, const glm::vec4& v1, const glm::vec4& v2);
+
+    void
+    addClippedTriangle(const glm::vec4& v0, const glm::vec4& v1, const glm::vec4& v2);
+
+    void
+    rasterizeTile(int tile);
+
+    void
+    reduceTile(int tile);
+
+    void
+    reduceLevel(std::size_t level);
+
+private:
+    int _width{};
+    int _height{};
+    int _tilesX{};
+    int _tilesY{};
+    std::vector<Level> _levels;
+    std::vector<Triangle> _triangles;
+    std::vector<std::vector<std::uint32_t>> _bins;
+    Stats _stats;
+};
+
+} // namespace glesy
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "glesy/Api.h"
+#include "glesy/GeometryHeap.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace glesy {
+
+/**
+ * Collector of indexed draws sharing vertex array, program and other state.
+ *
+ * Draw parameters (index counts, index offsets and base vertices) are gathered into arrays
+ * and submitted with single glMultiDrawElementsBaseVertex call on flush. Draws continuing
+ * the previous one in the index buffer with the same base vertex are merged.
+ */
+class DrawRun {
+public:
+    struct Stats {
+        /** The number of collected draws */
+        std::size_t draws{};
+        /** The number of issued multi-draw calls */
+        std::size_t calls{};
+
+        [[nodiscard]] float
+        drawsPerCall() const;
+    };
+
+    /**
+     * @param indexType The type of indices of all collected draws
+     * @param primitive The primitive type of all collected draws
+     */
+    explicit DrawRun(GLenum indexType = GL_UNSIGNED_INT, GLenum primitive = GL_TRIANGLES);
+
+    /**
+     * Add draw to the run
+     * @param count The number of indices to draw
+     * @param indexOffset The offset in bytes of the first index in bound index buffer
+     * @param baseVertex The value added to each index
+     */
+    void
+    add(GLsizei count, GLintptr indexOffset, GLint baseVertex = 0);
+
+    /**
+     * Add mesh from geometry heap to the run (index type of heap must match run one)
+     */
+    void
+    add(const GeometryHeap& heap, GeometryHeap::Handle handle);
+
+    /**
+     * Add level of detail of mesh from geometry heap to the run
+     * @param heap The geometry heap
+     * @param handle The mesh handle
+     * @param lod The level of detail (index range relative to the first mesh index)
+     */
+    void
+    add(const GeometryHeap& heap, GeometryHeap::Handle handle, const MeshLod& lod);
+
+    /**
+     * Add range of mesh indices from geometry heap to the run
+     * @param heap The geometry heap
+     * @param handle The mesh handle
+     * @param firstIndex The offset of the first index relative to the first mesh index
+     * @param count The number of indices to draw
+     */
+    void
+    add(const GeometryHeap& heap, GeometryHeap::Handle handle, GLuint firstIndex, GLsizei count);
+
+    /**
+     * Submit collected draws with single call and clear the run
+     * (vertex array and program must be bound)
+     */
+    void
+    flush();
+
+    /**
+     * Drop collected draws without submitting them
+     */
+    void
+    clear();
+
+    [[nodiscard]] bool
+    empty() const;
+
+    [[nodiscard]] std::size_t
+    size() const;
+
+    [[nodiscard]] GLenum
+    indexType() const;
+
+    [[nodiscard]] GLenum
+    primitive() const;
+
+    [[nodiscard]] const Stats&
+    stats() const;
+
+    void
+    resetStats();
+
+private:
+    GLenum _indexType{};
+    GLenum _primitive{};
+    std::size_t _indexSize{};
+    std::vector<GLsizei> _counts;
+    std::vector<const void*> _offsets;
+    std::vector<GLint> _baseVertices;
+    Stats _stats;
+};
+
+} // namespace glesy
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "glesy/Api.h"
+#include "glesy/GpuTimer.hpp"
+#include "glesy/RenderTarget.hpp"
+
+#include <cstddef>
+#include <optional>
+
+namespace glesy {
+
+struct DynamicResolutionSettings {
+    /** The GPU time budget of the scaled pass in milliseconds */
+    double budget{12.0};
+    float minScale{0.5f};
+    float maxScale{1.0f};
+    /** Scale grows when smoothed time is below this fraction of the budget */
+    double lowerThreshold{0.8};
+    /** Scale shrinks when smoothed time is above this fraction of the budget */
+    double upperThreshold{1.0};
+    /** Frames to keep the scale after change, so measurements catch up with it */
+    unsigned cooldownFrames{12};
+    /** Scales are rounded to multiples of the step */
+    float scaleStep{0.05f};
+    GLenum colorFormat{GL_RGBA8};
+    GLenum depthFormat{GL_DEPTH24_STENCIL8};
+};
+
+/**
+ * Offscreen scene target with resolution scaled by measured GPU time to keep the pass within
+ * the frame budget, for fill rate bound GPUs.
+ *
+ * Targets are allocated once at the maximum scale and the scene is rendered into their lower
+ * left region, so changing the scale never reallocates. Scale follows the ratio of budget and
+ * smoothed pass time (pixel count is proportional to the scale squared), changes only when the
+ * time leaves the threshold band and then holds for a cooldown period.
+ */
+class DynamicResolution {
+public:
+    /**
+     * @param settings The scaling settings
+     * @param outputWidth The output (window) width in pixels
+     * @param outputHeight The output (window) height in pixels
+     */
+    DynamicResolution(const DynamicResolutionSettings& settings,
+                      GLsizei outputWidth,
+                      GLsizei outputHeight);
+
+    /**
+     * Change output size (reallocates targets)
+     */
+    void
+    resize(GLsizei outputWidth, GLsizei outputHeight);
+
+    /**
+     * Bind scene framebuffer, set viewport to the scaled size and start GPU timing
+     */
+    void
+    begin();
+
+    /**
+     * Stop GPU timing and adjust scale for the next frame
+     */
+    void
+    end();
+
+    /**
+     * Upscale scene color to the output framebuffer
+     * @param framebuffer The output framebuffer (0 for default)
+     * @param filter The blit filter (GL_LINEAR or GL_NEAREST)
+     */
+    void
+    present(GLuint framebuffer = 0, GLenum filter = GL_LINEAR) const;
+
+    /**
+     * Feed pass time measurement into the scale controller (called by @c end)
+     * @return @c true if scale changed
+     */
+    bool
+    update(double milliseconds);
+
+    [[nodiscard]] float
+    scale() const;
+
+    /**
+     * Get the scaled scene width (rendered region of the color target)
+     */
+    [[nodiscard]] GLsizei
+    width() const;
+
+    [[nodiscard]] GLsizei
+    height() const;
+
+    /**
+     * Get smoothed GPU time of the scaled pass
+     */
+    [[nodiscard]] double
+    milliseconds() const;
+
+    /**
+     * Get scene color for custom upscale filters (valid region is width() x height())
+     */
+    [[nodiscard]] const RenderTarget&
+    color() const;
+
+private:
+    DynamicResolutionSettings _settings;
+    GLsizei _outputWidth{};
+    GLsizei _outputHeight{};
+    float _scale{};
+    double _smoothed{};
+    bool _measured{false};
+    unsigned _cooldown{};
+    std::size_t _samples{};
+    std::optional<RenderTarget> _color;
+    std::optional<RenderTarget> _depth;
+    Framebuffer _framebuffer;
+    GpuTimer _timer;
+};
+
+} // namespace glesy
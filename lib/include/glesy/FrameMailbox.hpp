@@ -0,0 +1,125 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace glesy {
+
+/**
+ * Lock-free triple buffer handing frame packets from one producer thread (simulation) to one
+ * consumer thread (rendering). The producer never waits: publishing replaces the packet not yet
+ * taken by the consumer, and the consumer always gets the latest complete packet.
+ *
+ * Slots are reused, so the packet returned by @c back holds data published a few frames ago
+ * and must be overwritten completely (or updated incrementally on purpose).
+ */
+template<typename T>
+class FrameMailbox {
+public:
+    /**
+     * Get packet to fill (producer)
+     */
+    [[nodiscard]] T&
+    back()
+    {
+        return _slots[_back];
+    }
+
+    /**
+     * Make filled packet available to the consumer (producer)
+     */
+    void
+    publish()
+    {
+        const auto fresh = static_cast<std::uint32_t>(_back) | kFresh;
+        const auto previous = _middle.exchange(fresh, std::memory_order_acq_rel);
+        _back = previous & kIndexMask;
+        if ((previous & kFresh) != 0) {
+            _dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+        _middle.notify_one();
+    }
+
+    /**
+     * Stop the consumer waiting for packets (producer, no packets may be published after)
+     */
+    void
+    close()
+    {
+        _middle.fetch_or(kClosed, std::memory_order_release);
+        _middle.notify_one();
+    }
+
+    /**
+     * Take the latest published packet if there is a new one (consumer)
+     * @return @c true if @c front changed
+     */
+    bool
+    acquire()
+    {
+        auto middle = _middle.load(std::memory_order_acquire);
+        do {
+            if ((middle & kFresh) == 0) {
+                return false;
+            }
+        } while (not _middle.compare_exchange_weak(middle,
+                                                   static_cast<std::uint32_t>(_front)
+                                                       | (middle & kClosed),
+                                                   std::memory_order_acq_rel,
+                                                   std::memory_order_acquire));
+        _front = middle & kIndexMask;
+        return true;
+    }
+
+    /**
+     * Block until new packet is published and take it (consumer)
+     * @return @c false if mailbox was closed and all packets are consumed
+     */
+    bool
+    wait()
+    {
+        while (not acquire()) {
+            const auto middle = _middle.load(std::memory_order_acquire);
+            if ((middle & kClosed) != 0) {
+                return false;
+            }
+            if ((middle & kFresh) == 0) {
+                _middle.wait(middle, std::memory_order_acquire);
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Get the last acquired packet (consumer)
+     */
+    [[nodiscard]] const T&
+    front() const
+    {
+        return _slots[_front];
+    }
+
+    /**
+     * Get the number of packets replaced before the consumer took them
+     */
+    [[nodiscard]] std::size_t
+    dropped() const
+    {
+        return _dropped.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr std::uint32_t kIndexMask{3};
+    static constexpr std::uint32_t kFresh{4};
+    static constexpr std::uint32_t kClosed{8};
+
+    std::array<T, 3> _slots{};
+    std::size_t _back{0};
+    std::size_t _front{1};
+    std::atomic<std::uint32_t> _middle{2};
+    std::atomic<std::size_t> _dropped{};
+};
+
+} // namespace glesy
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <chrono>
+
+namespace glesy {
+
+/**
+ * Caps the loop rate. Waits for the next frame slot by sleeping until shortly before the
+ * deadline and spinning the rest, because sleep granularity of the OS scheduler is too coarse
+ * for stable frame pacing.
+ */
+class FramePacer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @param maxFrameRate The frames per second limit (0 for unlimited)
+     * @param spinThreshold The time before deadline spent spinning instead of sleeping
+     */
+    explicit FramePacer(double maxFrameRate = 0,
+                        std::chrono::microseconds spinThreshold = std::chrono::microseconds{2000});
+
+    void
+    setMaxFrameRate(double maxFrameRate);
+
+    [[nodiscard]] double
+    maxFrameRate() const;
+
+    /**
+     * Block until the next frame slot. When the loop falls behind the schedule is reset
+     * instead of running frames back to back to catch up.
+     */
+    void
+    wait();
+
+private:
+    double _maxFrameRate{};
+    Clock::duration _period{};
+    Clock::duration _spinThreshold{};
+    Clock::time_point _next;
+};
+
+} // namespace glesy
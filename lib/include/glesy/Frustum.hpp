@@ -0,0 +1,41 @@
+#pragma once
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include <array>
+
+namespace glesy {
+
+/**
+ * View frustum as six normalized planes (left, right, bottom, top, near, far) with normals
+ * pointing inside
+ */
+struct Frustum {
+    enum Plane { Left, Right, Bottom, Top, Near, Far, PlaneCount };
+
+    std::array<glm::vec4, PlaneCount> planes;
+
+    /**
+     * Extract frustum planes from the projection matrix (OpenGL clip space)
+     * @param matrix The view-projection matrix (or model-view-projection for object space planes)
+     * @return The frustum
+     */
+    static Frustum
+    fromMatrix(const glm::mat4& matrix);
+
+    /**
+     * Check whether the sphere is at least partially inside the frustum
+     */
+    [[nodiscard]] bool
+    intersects(const glm::vec3& center, float radius) const;
+
+    /**
+     * Check whether the axis aligned box is at least partially inside the frustum
+     */
+    [[nodiscard]] bool
+    intersects(const glm::vec3& minimum, const glm::vec3& maximum) const;
+};
+
+} // namespace glesy
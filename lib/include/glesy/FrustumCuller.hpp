@@ -0,0 +1,89 @@
+#pragma once
+
+#include "glesy/Frustum.hpp"
+
+#include <glm/vec3.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace glesy {
+
+/**
+ * Frustum culling of scene objects. Bounding volumes are kept in structure-of-arrays form and
+ * tested eight objects at a time (AVX2 when the CPU supports it, two SSE2 or NEON blocks
+ * otherwise), object ranges are processed in parallel.
+ *
+ * Every object has a bounding sphere and an axis aligned box sharing the same center, and the
+ * tighter one is used against each plane. Objects added as boxes get the box circumscribed
+ * sphere, objects added as spheres get the sphere enclosing cube.
+ */
+class FrustumCuller {
+public:
+    /**
+     * Add object bounded by the axis aligned box
+     * @return The object index
+     */
+    std::uint32_t
+    addBox(const glm::vec3& minimum, const glm::vec3& maximum);
+
+    /**
+     * Add object bounded by the sphere
+     * @return The object index
+     */
+    std::uint32_t
+    addSphere(const glm::vec3& center, float radius);
+
+    /**
+     * Add object bounded by both the sphere and the box centered at the same point
+     * @return The object index
+     */
+    std::uint32_t
+    add(const glm::vec3& center, float radius, const glm::vec3& extents);
+
+    /**
+     * Update bounds of the object (e.g. after it moved)
+     */
+    void
+    setBox(std::uint32_t index, const glm::vec3& minimum, const glm::vec3& maximum);
+
+    void
+    setSphere(std::uint32_t index, const glm::vec3& center, float radius);
+
+    void
+    set(std::uint32_t index, const glm::vec3& center, float radius, const glm::vec3& extents);
+
+    void
+    reserve(std::size_t count);
+
+    void
+    clear();
+
+    [[nodiscard]] std::size_t
+    size() const;
+
+    /**
+     * Collect objects at least partially inside the frustum
+     * @param frustum The view frustum (in space of bounding volumes)
+     * @param visible The output indices of visible objects in ascending order
+     * @param grain The minimum number of objects culled by one task
+     * @return The number of visible objects
+     */
+    std::size_t
+    cull(const Frustum& frustum,
+         std::vector<std::uint32_t>& visible,
+         std::size_t grain = 16384) const;
+
+private:
+    std::vector<float> _centerX;
+    std::vector<float> _centerY;
+    std::vector<float> _centerZ;
+    std::vector<float> _radius;
+    std::vector<float> _extentX;
+    std::vector<float> _extentY;
+    std::vector<float> _extentZ;
+    std::size_t _count{};
+};
+
+} // namespace glesy
@@ -0,0 +1,179 @@
+#pragma once
+
+#include "glesy/Api.h"
+#include "glesy/Buffer.hpp"
+#include "glesy/MeshLod.hpp"
+#include "glesy/RangeAllocator.hpp"
+#include "glesy/VertexArray.hpp"
+#include "glesy/VertexFormat.hpp"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace glesy {
+
+/**
+ * Location of the mesh inside geometry heap buffers
+ */
+struct GeometryRange {
+    /** The offset of the first mesh vertex (in vertices) */
+    GLint baseVertex{};
+    GLsizei vertexCount{};
+    /** The offset of the first mesh index (in indices) */
+    GLsizei firstIndex{};
+    GLsizei indexCount{};
+};
+
+/**
+ * Large shared vertex and index buffers of single vertex format sub-allocated between many
+ * meshes. Meshes are drawn with glDrawElementsBaseVertex from one vertex array, so drawing
+ * them doesn't require rebinding vertex array or buffers. Buffers grow on demand, released
+ * ranges are reused and can be compacted with defragment().
+ */
+class GeometryHeap {
+public:
+    using Handle = std::uint32_t;
+
+    static constexpr Handle kInvalidHandle{~Handle{0}};
+
+    /**
+     * Create heap
+     * @param format The vertex format of all meshes in the heap
+     * @param vertexCapacity The initial capacity of vertex buffer (in vertices)
+     * @param indexCapacity The initial capacity of index buffer (in indices)
+     * @param indexType The type of indices (GL_UNSIGNED_SHORT limits mesh size to 65536 vertices)
+     */
+    GeometryHeap(const VertexFormat& format,
+                 GLsizei vertexCapacity,
+                 GLsizei indexCapacity,
+                 GLenum indexType = GL_UNSIGNED_INT);
+
+    GeometryHeap(const GeometryHeap&) = delete;
+
+    GeometryHeap&
+    operator=(const GeometryHeap&)
+        = delete;
+
+    /**
+     * Upload mesh into the heap
+     * @param vertices The vertex data in heap vertex format
+     * @param verticesSize The size of vertex data in bytes
+     * @param indices The mesh indices relative to the first mesh vertex
+     * @return The handle of mesh
+     */
+    [[nodiscard]] Handle
+    allocate(const void* vertices, GLsizeiptr verticesSize, std::span<const GLuint> indices);
+
+    template<typename Vertex>
+    [[nodiscard]] Handle
+    allocate(std::span<const Vertex> vertices, std::span<const GLuint> indices)
+    {
+        return allocate(
+            vertices.data(), static_cast<GLsizeiptr>(vertices.size_bytes()), indices);
+    }
+
+    /**
+     * Release mesh space (handle becomes invalid)
+     */
+    void
+    release(Handle handle);
+
+    [[nodiscard]] bool
+    contains(Handle handle) const;
+
+    /**
+     * Get current location of mesh (changes on defragmentation)
+     */
+    [[nodiscard]] const GeometryRange&
+    range(Handle handle) const;
+
+    /**
+     * Get offset in bytes of the first mesh index inside index buffer
+     */
+    [[nodiscard]] GLintptr
+    indexOffset(Handle handle) const;
+
+    /**
+     * Bind heap vertex array, required before drawing heap meshes
+     */
+    void
+    bind() const;
+
+    /**
+     * Draw mesh from the heap (heap must be bound)
+     * @param handle The mesh handle
+     * @param primitive The primitive type to draw
+     */
+    void
+    draw(Handle handle, GLenum primitive = GL_TRIANGLES) const;
+
+    /**
+     * Draw level of detail of mesh from the heap (heap must be bound)
+     * @param handle The mesh handle
+     * @param lod The level of detail (index range relative to the first mesh index)
+     * @param primitive The primitive type to draw
+     */
+    void
+    draw(Handle handle, const MeshLod& lod, GLenum primitive = GL_TRIANGLES) const;
+
+    /**
+     * Move all meshes to the beginning of buffers removing gaps between them
+     */
+    void
+    defragment();
+
+    /**
+     * Get fragmentation of free space of heap buffers
+     * @return 0 if free space is contiguous, values near 1 for scattered free space
+     */
+    [[nodiscard]] float
+    fragmentation() const;
+
+    [[nodiscard]] const VertexFormat&
+    format() const;
+
+    [[nodiscard]] GLenum
+    indexType() const;
+
+    [[nodiscard]] const VertexArray&
+    vertexArray() const;
+
+    [[nodiscard]] const Buffer&
+    vertexBuffer() const;
+
+    [[nodiscard]] const Buffer&
+    indexBuffer() const;
+
+    [[nodiscard]] std::size_t
+    meshCount() const;
+
+private:
+    struct Slot {
+        GeometryRange range;
+        bool live{false};
+    };
+
+    void
+    reserve(std::size_t vertexCapacity, std::size_t indexCapacity);
+
+    [[nodiscard]] Buffer
+    makeIndexBuffer(std::size_t capacity) const;
+
+    void
+    attachBuffers();
+
+private:
+    VertexFormat _format;
+    GLenum _indexType{};
+    std::size_t _indexSize{};
+    VertexArray _vertexArray;
+    Buffer _vertices;
+    Buffer _indices{GL_ELEMENT_ARRAY_BUFFER};
+    RangeAllocator _vertexAllocator;
+    RangeAllocator _indexAllocator;
+    std::vector<Slot> _slots;
+    std::vector<Handle> _freeHandles;
+};
+
+} // namespace glesy
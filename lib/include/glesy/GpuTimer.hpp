@@ -0,0 +1,78 @@
+#pragma once
+
+#include "glesy/Api.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace glesy {
+
+/**
+ * Measures GPU time of the command range with a pair of GL_TIMESTAMP queries, so measured ranges
+ * may nest (unlike GL_TIME_ELAPSED queries). Results are read a few frames later from a ring of
+ * query pairs, so measuring never stalls the pipeline. Frames where every pair is still in
+ * flight are not measured.
+ */
+class GpuTimer {
+public:
+    /**
+     * @param latency The number of query pairs in flight (frames of result delay)
+     */
+    explicit GpuTimer(std::size_t latency = 4);
+
+    GpuTimer(const GpuTimer&) = delete;
+
+    GpuTimer&
+    operator=(const GpuTimer&)
+        = delete;
+
+    ~GpuTimer();
+
+    /**
+     * Start measured range
+     */
+    void
+    begin();
+
+    /**
+     * Finish measured range
+     */
+    void
+    end();
+
+    /**
+     * Get the last available measurement in milliseconds
+     */
+    [[nodiscard]] double
+    milliseconds() const;
+
+    /**
+     * Check whether at least one measurement is available
+     */
+    [[nodiscard]] bool
+    ready() const;
+
+    /**
+     * Get the number of measurements read so far (to detect new ones)
+     */
+    [[nodiscard]] std::size_t
+    samples() const;
+
+private:
+    [[nodiscard]] std::size_t
+    pairs() const;
+
+    void
+    collect();
+
+private:
+    std::vector<GLuint> _queries;
+    std::size_t _head{};
+    std::size_t _pending{};
+    bool _active{false};
+    bool _ready{false};
+    std::size_t _samples{};
+    double _milliseconds{};
+};
+
+} // namespace glesy
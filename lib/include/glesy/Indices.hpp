@@ -0,0 +1,57 @@
+#pragma once
+
+#include "glesy/Api.h"
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace glesy {
+
+/**
+ * Marker of strip end in 32-bit index lists (replaced with the maximum value of
+ * the selected index type on packing)
+ */
+inline constexpr GLuint kPrimitiveRestartIndex{~0U};
+
+/**
+ * Select the smallest index type able to address given number of vertices
+ * @param vertexCount The number of vertices
+ * @param primitiveRestart Whether the maximum value of type is reserved for primitive restart
+ * @return GL_UNSIGNED_BYTE, GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
+ */
+[[nodiscard]] GLenum
+selectIndexType(std::size_t vertexCount, bool primitiveRestart = false);
+
+/**
+ * Get size of index type in bytes
+ */
+[[nodiscard]] std::size_t
+indexTypeSize(GLenum type);
+
+/**
+ * Get primitive restart index of index type (the maximum value of type)
+ */
+[[nodiscard]] GLuint
+primitiveRestartIndex(GLenum type);
+
+/**
+ * Convert 32-bit indices into indices of given type (kPrimitiveRestartIndex is converted
+ * into restart index of type)
+ * @param indices The 32-bit indices
+ * @param type The target index type
+ * @return The raw index data ready for upload
+ */
+[[nodiscard]] std::vector<std::byte>
+packIndices(std::span<const GLuint> indices, GLenum type);
+
+/**
+ * Convert triangle list into triangle strips separated by kPrimitiveRestartIndex
+ * (winding order is preserved)
+ * @param indices The triangle list indices
+ * @return The triangle strip indices
+ */
+[[nodiscard]] std::vector<GLuint>
+stripify(std::span<const GLuint> indices);
+
+} // namespace glesy
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "glesy/Api.h"
+#include "glesy/Buffer.hpp"
+#include "glesy/Mesh.hpp"
+#include "glesy/VertexLayout.hpp"
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+
+#include <span>
+#include <stdexcept>
+
+namespace glesy {
+
+/**
+ * Common per-instance data: model transform, texture coordinates rectangle and color
+ */
+struct InstanceData {
+    glm::mat4 transform{1.0f};
+    glm::vec4 uvRect{0.0f, 0.0f, 1.0f, 1.0f};
+    glm::u8vec4 color{255, 255, 255, 255};
+};
+
+/**
+ * Layout of InstanceData stream. Occupies six attribute locations starting from given one
+ * ("mat4" transform, "vec4" texture coordinates rectangle and "vec4" color).
+ */
+template<GLuint Location>
+using InstanceDataLayout = VertexLayout<FloatAttr<Location, 4>,
+                                        FloatAttr<Location + 1, 4>,
+                                        FloatAttr<Location + 2, 4>,
+                                        FloatAttr<Location + 3, 4>,
+                                        FloatAttr<Location + 4, 4>,
+                                        UNorm8Attr<Location + 5, 4>>;
+
+/**
+ * Typed stream of per-instance attributes stored in its own buffer
+ * @tparam Instance The per-instance data type
+ * @tparam Layout The VertexLayout describing instance type
+ */
+template<typename Instance, typename Layout>
+class InstanceBuffer {
+public:
+    static_assert(sizeof(Instance) == Layout::kStride, "Instance type doesn't match its layout");
+
+    explicit InstanceBuffer(const std::size_t capacity)
+        : _buffer{GL_ARRAY_BUFFER,
+                  static_cast<GLsizeiptr>(capacity * sizeof(Instance)),
+                  nullptr,
+                  GL_STREAM_DRAW}
+        , _capacity{capacity}
+    {
+    }
+
+    [[nodiscard]] const Buffer&
+    buffer() const
+    {
+        return _buffer;
+    }
+
+    [[nodiscard]] std::size_t
+    capacity() const
+    {
+        return _capacity;
+    }
+
+    [[nodiscard]] std::size_t
+    size() const
+    {
+        return _size;
+    }
+
+    /**
+     * Replace content of the stream (previous storage is orphaned to avoid stalls)
+     * @param instances The per-instance data
+     */
+    void
+    update(std::span<const Instance> instances)
+    {
+        if (instances.size() > _capacity) {
+            throw std::length_error("Too many instances");
+        }
+        _buffer.setData(
+            static_cast<GLsizeiptr>(_capacity * sizeof(Instance)), nullptr, GL_STREAM_DRAW);
+        _buffer.setSubData(0, static_cast<GLsizeiptr>(instances.size_bytes()), instances.data());
+        _size = instances.size();
+    }
+
+    /**
+     * Feed per-instance attributes of the mesh from this stream
+     * @param mesh The mesh to attach stream to
+     */
+    void
+    attachTo(Mesh& mesh) const
+    {
+        mesh.attachInstances(_buffer, Layout::instanceFormat());
+    }
+
+    /**
+     * Draw one mesh instance per element of the stream
+     * @param mesh The mesh this stream was attached to
+     */
+    void
+    draw(const Mesh& mesh) const
+    {
+        mesh.drawInstanced(static_cast<GLsizei>(_size));
+    }
+
+private:
+    Buffer _buffer;
+    std::size_t _capacity{};
+    std::size_t _size{};
+};
+
+} // namespace glesy
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "glesy/Api.h"
+#include "glesy/Buffer.hpp"
+#include "glesy/Shader.hpp"
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace glesy {
+
+struct PointLight {
+    glm::vec3 position{};
+    /** The distance where light contribution fades to zero */
+    float radius{1.0f};
+    glm::vec3 color{1.0f};
+    float intensity{1.0f};
+};
+
+/**
+ * Tiled forward+ light culling. Light bounding spheres are projected to screen rectangles four
+ * lights at a time (SSE2 or NEON) and binned into screen tiles in parallel, tile light lists
+ * are uploaded to a texture buffer and the fragment shader loops only over lights of its tile.
+ *
+ * Shaders include the @c shaderSource snippet after the version line and iterate tile lights:
+ * @code
+ * int tile = lightTile();
+ * for (int index = 0; index < lightTileCount(tile); ++index) {
+ *     PointLight light = lightTileLight(tile, index);
+ *     ...
+ * }
+ * @endcode
+ *
+ * Only perspective projections are supported, tiles are addressed by @c gl_FragCoord so the
+ * viewport must start at the origin and match the culler size.
+ */
+class LightCuller {
+public:
+    static constexpr GLsizei kDefaultTileSize{16};
+    static constexpr GLuint kDefaultLightUnit{14};
+    static constexpr GLuint kDefaultTileUnit{15};
+
+    struct Stats {
+        std::size_t lights{};
+        std::size_t visible{};
+        std::size_t references{};
+        std::size_t maxPerTile{};
+    };
+
+    /**
+     * @param width The viewport width in pixels
+     * @param height The viewport height in pixels
+     * @param tileSize The tile size in pixels
+     */
+    LightCuller(GLsizei width, GLsizei height, GLsizei tileSize = kDefaultTileSize);
+
+    LightCuller(const LightCuller&) = delete;
+
+    LightCuller&
+    operator=(const LightCuller&)
+        = delete;
+
+    ~LightCuller();
+
+    void
+    resize(GLsizei width, GLsizei height);
+
+    /**
+     * Bin lights into screen tiles (CPU only, no GL calls)
+     * @param lights The lights in world space
+     * @param view The view matrix
+     * @param projection The perspective projection matrix
+     * @param grain The minimum number of lights projected by one task
+     */
+    void
+    cull(std::span<const PointLight> lights,
+         const glm::mat4& view,
+         const glm::mat4& projection,
+         std::size_t grain = 1024);
+
+    /**
+     * Upload visible lights and tile lists of the last @c cull to texture buffers
+     */
+    void
+    upload();
+
+    /**
+     * Bind texture buffers and set snippet uniforms of the program in use
+     */
+    void
+    bind(const Shader& shader,
+         GLuint lightUnit = kDefaultLightUnit,
+         GLuint tileUnit = kDefaultTileUnit) const;
+
+    /**
+     * Get GLSL snippet declaring uniforms, @c PointLight structure and tile access functions
+     */
+    [[nodiscard]] static const char*
+    shaderSource();
+
+    [[nodiscard]] GLsizei
+    tileSize() const;
+
+    [[nodiscard]] GLsizei
+    tilesX() const;
+
+    [[nodiscard]] GLsizei
+    tilesY() const;
+
+    /**
+     * Get tile data: (offset, count) pair per tile followed by light indices
+     */
+    [[nodiscard]] std::span<const std::uint32_t>
+    tiles() const;
+
+    /**
+     * Get indices of visible lights in order they are referenced by tile data
+     */
+    [[nodiscard]] std::span<const std::uint32_t>
+    visibleLights() const;
+
+    [[nodiscard]] const Stats&
+    stats() const;
+
+private:
+    GLsizei _width{};
+    GLsizei _height{};
+    GLsizei _tileSize{};
+    GLsizei _tilesX{};
+    GLsizei _tilesY{};
+
+    std::vector<float> _x;
+    std::vector<float> _y;
+    std::vector<float> _z;
+    std::vector<float> _radius;
+    std::vector<std::int32_t> _minX;
+    std::vector<std::int32_t> _maxX;
+    std::vector<std::int32_t> _minY;
+    std::vector<std::int32_t> _maxY;
+    std::vector<std::uint8_t> _visible;
+
+    std::vector<std::uint32_t> _visibleLights;
+    std::vector<std::uint32_t> _counts;
+    std::vector<std::uint32_t> _tiles;
+    std::vector<float> _lightData;
+    Stats _stats;
+
+    std::optional<Buffer> _lightBuffer;
+    std::optional<Buffer> _tileBuffer;
+    GLuint _lightTexture{};
+    GLuint _tileTexture{};
+};
+
+} // namespace glesy
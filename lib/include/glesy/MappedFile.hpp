@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <string_view>
+
+namespace glesy {
+
+/**
+ * Read-only memory mapping of the whole file
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const std::filesystem::path& filePath);
+
+    MappedFile(MappedFile&& other) noexcept;
+
+    MappedFile&
+    operator=(MappedFile&& other) noexcept;
+
+    ~MappedFile();
+
+    [[nodiscard]] std::span<const std::byte>
+    bytes() const;
+
+    [[nodiscard]] std::string_view
+    text() const;
+
+    [[nodiscard]] std::size_t
+    size() const;
+
+private:
+    void
+    release();
+
+private:
+    const std::byte* _data{};
+    std::size_t _size{};
+};
+
+} // namespace glesy
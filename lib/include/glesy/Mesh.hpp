@@ -0,0 +1,142 @@
+#pragma once
+
+#include "glesy/Api.h"
+#include "glesy/Buffer.hpp"
+#include "glesy/MeshLod.hpp"
+#include "glesy/VertexArray.hpp"
+#include "glesy/VertexFormat.hpp"
+
+#include <span>
+#include <vector>
+
+namespace glesy {
+
+/**
+ * Indexed geometry uploaded into GPU buffers together with vertex array describing it.
+ * Indices are stored using the smallest type able to address referenced vertices, and
+ * kPrimitiveRestartIndex entries enable primitive restart on drawing.
+ */
+class Mesh {
+public:
+    Mesh(const void* vertices,
+         GLsizeiptr verticesSize,
+         const VertexFormat& format,
+         std::span<const GLuint> indices,
+         GLenum primitive = GL_TRIANGLES);
+
+    /**
+     * Create mesh from already packed indices (e.g. cooked data)
+     * @param vertices The vertex data
+     * @param verticesSize The size of vertex data in bytes
+     * @param format The layout of vertex data
+     * @param indices The index data
+     * @param indexCount The number of indices
+     * @param indexType The type of indices
+     * @param primitive The primitive type
+     * @param primitiveRestart Whether indices contain primitive restart index of their type
+     */
+    Mesh(const void* vertices,
+         GLsizeiptr verticesSize,
+         const VertexFormat& format,
+         const void* indices,
+         GLsizei indexCount,
+         GLenum indexType,
+         GLenum primitive = GL_TRIANGLES,
+         bool primitiveRestart = false);
+
+    template<typename Vertex>
+    Mesh(std::span<const Vertex> vertices,
+         const VertexFormat& format,
+         std::span<const GLuint> indices,
+         GLenum primitive = GL_TRIANGLES)
+        : Mesh{vertices.data(),
+               static_cast<GLsizeiptr>(vertices.size_bytes()),
+               format,
+               indices,
+               primitive}
+    {
+    }
+
+    [[nodiscard]] const VertexArray&
+    vertexArray() const;
+
+    [[nodiscard]] const Buffer&
+    vertexBuffer() const;
+
+    [[nodiscard]] const Buffer&
+    indexBuffer() const;
+
+    [[nodiscard]] const VertexFormat&
+    format() const;
+
+    [[nodiscard]] GLsizei
+    indexCount() const;
+
+    [[nodiscard]] GLenum
+    indexType() const;
+
+    [[nodiscard]] GLenum
+    primitive() const;
+
+    [[nodiscard]] bool
+    primitiveRestart() const;
+
+    /**
+     * Set levels of detail stored in the index buffer (by default the whole index buffer is
+     * the only level)
+     */
+    void
+    setLods(std::vector<MeshLod> lods);
+
+    [[nodiscard]] const std::vector<MeshLod>&
+    lods() const;
+
+    /**
+     * Attach buffer with per-instance attributes to the mesh vertex array
+     * @param buffer The instance buffer
+     * @param format The layout of instance buffer (attributes must have non-zero divisor)
+     */
+    void
+    attachInstances(const Buffer& buffer, const VertexFormat& format);
+
+    /**
+     * Draw mesh
+     * @param lod The level of detail to draw
+     */
+    void
+    draw(std::size_t lod = 0) const;
+
+    /**
+     * Draw given number of mesh instances with single draw call
+     * @param instanceCount The number of instances to draw
+     * @param lod The level of detail to draw
+     */
+    void
+    drawInstanced(GLsizei instanceCount, std::size_t lod = 0) const;
+
+private:
+    void
+    setIndices(const void* indices);
+
+    [[nodiscard]] const void*
+    lodOffset(const MeshLod& lod) const;
+
+    void
+    beginDraw() const;
+
+    void
+    endDraw() const;
+
+private:
+    Buffer _vertices;
+    Buffer _indices;
+    VertexArray _vertexArray;
+    VertexFormat _format;
+    GLsizei _indexCount{};
+    GLenum _indexType{GL_UNSIGNED_INT};
+    GLenum _primitive{};
+    bool _primitiveRestart{false};
+    std::vector<MeshLod> _lods;
+};
+
+} // namespace glesy
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "glesy/Api.h"
+#include "glesy/AssetHash.hpp"
+#include "glesy/MappedFile.hpp"
+#include "glesy/Mesh.hpp"
+#include "glesy/MeshData.hpp"
+#include "glesy/MeshLod.hpp"
+#include "glesy/MeshSimplifier.hpp"
+#include "glesy/VertexFormat.hpp"
+
+#include <glm/vec3.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace glesy {
+
+/** Version of cooked mesh format and cooking pipeline (bump to invalidate all caches) */
+inline constexpr std::uint32_t kMeshCacheVersion{2};
+
+/**
+ * Processing applied to the source mesh before it is written to the cache
+ */
+struct MeshCookOptions {
+    bool optimize{true};
+    /** The maximum number of levels of detail (1 disables generation) */
+    std::size_t maxLods{kDefaultMaxLods};
+    float lodReduction{kDefaultLodReduction};
+};
+
+/**
+ * Source asset identity stored in the cooked mesh for staleness checks
+ */
+struct MeshSource {
+    /** The hash of source files content together with cooker version and options */
+    std::uint64_t hash{};
+    /** The hash of cooker version and options */
+    std::uint64_t cookerHash{};
+    /** The stamps of every source file */
+    std::vector<FileStamp> files;
+};
+
+/**
+ * Write mesh into cooked binary file: header followed by vertex format descriptors, levels of
+ * detail, source file stamps and aligned vertex and index blobs in GPU ready form (indices use
+ * the smallest type)
+ * @param mesh The mesh to write
+ * @param cachePath The output file (replaced atomically)
+ * @param source The source asset identity stored for staleness checks
+ */
+void
+cookMesh(const MeshData& mesh, const std::filesystem::path& cachePath, const MeshSource& source);
+
+/**
+ * Memory mapped cooked mesh, no parsing or conversion is done on loading
+ */
+class CookedMesh {
+public:
+    /**
+     * Map cooked mesh file
+     * @param cachePath The cooked mesh file
+     * @throw std::runtime_error if file isn't a valid cooked mesh of current version
+     */
+    explicit CookedMesh(const std::filesystem::path& cachePath);
+
+    [[nodiscard]] std::uint64_t
+    sourceHash() const;
+
+    [[nodiscard]] std::uint64_t
+    cookerHash() const;
+
+    [[nodiscard]] const std::vector<FileStamp>&
+    sourceFiles() const;
+
+    /**
+     * Check that mesh was cooked by given cooker and its source files didn't change since
+     * (compares file sizes and modification times, file contents are not read)
+     */
+    [[nodiscard]] bool
+    upToDate(std::uint64_t cookerHash) const;
+
+    [[nodiscard]] const VertexFormat&
+    format() const;
+
+    [[nodiscard]] const std::vector<MeshLod>&
+    lods() const;
+
+    [[nodiscard]] const glm::vec3&
+    boundsMin() const;
+
+    [[nodiscard]] const glm::vec3&
+    boundsMax() const;
+
+    [[nodiscard]] GLsizei
+    vertexCount() const;
+
+    [[nodiscard]] GLsizei
+    indexCount() const;
+
+    [[nodiscard]] GLenum
+    indexType() const;
+
+    /**
+     * Get vertex blob inside the mapping
+     */
+    [[nodiscard]] std::span<const std::byte>
+    vertices() const;
+
+    /**
+     * Get index blob inside the mapping
+     */
+    [[nodiscard]] std::span<const std::byte>
+    indices() const;
+
+    /**
+     * Upload blobs straight from the mapping into GPU buffers
+     */
+    [[nodiscard]] Mesh
+    upload() const;
+
+private:
+    MappedFile _file;
+    std::uint64_t _sourceHash{};
+    std::uint64_t _cookerHash{};
+    std::vector<FileStamp> _sourceFiles;
+    VertexFormat _format;
+    std::vector<MeshLod> _lods;
+    glm::vec3 _boundsMin{};
+    glm::vec3 _boundsMax{};
+    GLsizei _vertexCount{};
+    GLsizei _indexCount{};
+    GLenum _indexType{};
+    std::span<const std::byte> _vertices;
+    std::span<const std::byte> _indices;
+};
+
+/**
+ * Map cooked mesh, cooking it from the source asset first if cache is missing or stale.
+ * Cache is stale when size or modification time of any source file changed.
+ * @param sourcePath The source mesh file (formats supported by MeshData::load())
+ * @param cachePath The cooked mesh file
+ * @param options The cooking options (changing them invalidates the cache)
+ * @return The cooked mesh
+ */
+[[nodiscard]] CookedMesh
+loadOrCookMesh(const std::filesystem::path& sourcePath,
+               const std::filesystem::path& cachePath,
+               const MeshCookOptions& options = {});
+
+} // namespace glesy
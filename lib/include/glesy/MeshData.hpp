@@ -0,0 +1,70 @@
+#pragma once
+
+#include "glesy/Api.h"
+#include "glesy/Mesh.hpp"
+#include "glesy/VertexLayout.hpp"
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <filesystem>
+#include <vector>
+
+namespace glesy {
+
+struct MeshVertex {
+    glm::vec3 position;
+    glm::vec3 normal;
+    glm::vec2 texCoord;
+
+    bool
+    operator==(const MeshVertex&) const
+        = default;
+};
+
+/**
+ * Layout of MeshVertex: "layout(location = 0) in vec3" (position),
+ * "layout(location = 1) in vec3" (normal) and "layout(location = 2) in vec2" (texture coordinates)
+ */
+using MeshVertexLayout = VertexLayout<FloatAttr<0, 3>, FloatAttr<1, 3>, FloatAttr<2, 2>>;
+
+/**
+ * Indexed triangle list with deduplicated interleaved vertices ready for upload
+ */
+struct MeshData {
+    std::vector<MeshVertex> vertices;
+    std::vector<GLuint> indices;
+    /** The levels of detail as ranges of indices (empty if indices form single level) */
+    std::vector<MeshLod> lods;
+    /** The files read by the loader (source file and external files it references) */
+    std::vector<std::filesystem::path> files;
+
+    /**
+     * Load mesh from Wavefront OBJ or glTF 2.0 (.gltf or .glb) file depending on extension
+     */
+    static MeshData
+    load(const std::filesystem::path& filePath);
+
+    /**
+     * Load mesh from Wavefront OBJ file (polygons are triangulated, materials are ignored)
+     */
+    static MeshData
+    loadObj(const std::filesystem::path& filePath);
+
+    /**
+     * Load all triangle primitives of the default scene of glTF 2.0 file (.gltf or .glb)
+     * with node transforms applied
+     */
+    static MeshData
+    loadGltf(const std::filesystem::path& filePath);
+
+    /**
+     * Upload vertices and indices into GPU buffers
+     * @param primitive GL_TRIANGLES to upload triangle list as is or GL_TRIANGLE_STRIP to
+     * convert it into triangle strips joined by primitive restart (single level of detail only)
+     */
+    [[nodiscard]] Mesh
+    upload(GLenum primitive = GL_TRIANGLES) const;
+};
+
+} // namespace glesy
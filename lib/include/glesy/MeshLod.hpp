@@ -0,0 +1,44 @@
+#pragma once
+
+#include "glesy/Api.h"
+
+#include <cstddef>
+#include <span>
+
+namespace glesy {
+
+/**
+ * Level of detail of the mesh: range of the shared index buffer referencing the same vertices
+ */
+struct MeshLod {
+    /** The offset of the first LOD index (in indices) */
+    GLuint firstIndex{};
+    GLuint indexCount{};
+    /** The maximum geometric deviation from the full detail mesh in object units */
+    float error{};
+};
+
+/**
+ * Get number of pixels covered by unit length at unit distance from camera
+ * @param fovY The vertical field of view in radians
+ * @param viewportHeight The height of viewport in pixels
+ * @return The screen scale factor
+ */
+[[nodiscard]] float
+lodScreenScale(float fovY, float viewportHeight);
+
+/**
+ * Select the coarsest level of detail with projected error within threshold
+ * @param lods The levels of detail ordered from the finest to the coarsest
+ * @param distance The distance from camera to the mesh in object units
+ * @param screenScale The screen scale factor returned by lodScreenScale()
+ * @param maxPixelError The maximum allowed error in pixels
+ * @return The index of level of detail
+ */
+[[nodiscard]] std::size_t
+selectLod(std::span<const MeshLod> lods,
+          float distance,
+          float screenScale,
+          float maxPixelError = 1.0f);
+
+} // namespace glesy
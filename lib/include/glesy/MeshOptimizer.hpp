@@ -0,0 +1,96 @@
+#pragma once
+
+#include "glesy/Api.h"
+#include "glesy/MeshData.hpp"
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace glesy {
+
+inline constexpr std::size_t kDefaultVertexCacheSize{16};
+inline constexpr float kDefaultOverdrawThreshold{1.05f};
+
+/**
+ * Post-transform vertex cache efficiency of the index buffer (FIFO cache model)
+ */
+struct VertexCacheStats {
+    /** Average cache miss ratio: transformed vertices per triangle (0.5 is ideal, 3 is worst) */
+    float acmr{};
+    /** Average transform to vertex ratio: transformed vertices per used vertex (1 is ideal) */
+    float atvr{};
+};
+
+struct MeshOptimizationReport {
+    VertexCacheStats before;
+    VertexCacheStats after;
+};
+
+/**
+ * Simulate FIFO post-transform vertex cache for the triangle list
+ * @param indices The triangle list indices
+ * @param vertexCount The number of vertices
+ * @param cacheSize The number of entries in the cache
+ * @return The cache efficiency
+ */
+[[nodiscard]] VertexCacheStats
+analyzeVertexCache(std::span<const GLuint> indices,
+                   std::size_t vertexCount,
+                   std::size_t cacheSize = kDefaultVertexCacheSize);
+
+/**
+ * Reorder triangles for post-transform vertex cache hits (Tipsify algorithm)
+ * @param indices The triangle list indices
+ * @param vertexCount The number of vertices
+ * @param cacheSize The number of entries in the cache
+ * @param clusters The output offsets (in triangles) where algorithm hit dead-end and restarted
+ *                 at unrelated vertex, optional
+ * @return The reordered triangle list indices
+ */
+[[nodiscard]] std::vector<GLuint>
+optimizeVertexCache(std::span<const GLuint> indices,
+                    std::size_t vertexCount,
+                    std::size_t cacheSize = kDefaultVertexCacheSize,
+                    std::vector<std::size_t>* clusters = nullptr);
+
+/**
+ * Reorder triangle clusters of cache optimized index buffer to reduce overdraw
+ * (outward facing clusters are drawn first). Clusters are split while their cache
+ * efficiency stays within threshold of the original one.
+ * @param indices The triangle list indices optimized by optimizeVertexCache()
+ * @param clusters The dead-end offsets reported by optimizeVertexCache()
+ * @param vertices The mesh vertices
+ * @param cacheSize The number of entries in the cache
+ * @param threshold The allowed ACMR degradation (1.05 allows 5% more cache misses)
+ * @return The reordered triangle list indices
+ */
+[[nodiscard]] std::vector<GLuint>
+optimizeOverdraw(std::span<const GLuint> indices,
+                 std::span<const std::size_t> clusters,
+                 std::span<const MeshVertex> vertices,
+                 std::size_t cacheSize = kDefaultVertexCacheSize,
+                 float threshold = kDefaultOverdrawThreshold);
+
+/**
+ * Reorder vertices in the order of first use by index buffer (unused vertices are dropped)
+ * @param mesh The mesh to reorder
+ */
+void
+optimizeVertexFetch(MeshData& mesh);
+
+/**
+ * Run vertex cache, overdraw and vertex fetch optimizations (at cook or load time).
+ * Every level of detail is optimized separately. Cache efficiency of the full detail level
+ * before and after is printed to output log.
+ * @param mesh The mesh to optimize
+ * @param cacheSize The number of entries in the cache
+ * @param overdrawThreshold The allowed ACMR degradation for overdraw optimization
+ * @return The cache efficiency before and after optimization
+ */
+MeshOptimizationReport
+optimizeMesh(MeshData& mesh,
+             std::size_t cacheSize = kDefaultVertexCacheSize,
+             float overdrawThreshold = kDefaultOverdrawThreshold);
+
+} // namespace glesy
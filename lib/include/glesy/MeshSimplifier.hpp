@@ -0,0 +1,50 @@
+#pragma once
+
+#include "glesy/Api.h"
+#include "glesy/MeshData.hpp"
+
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace glesy {
+
+inline constexpr std::size_t kDefaultMaxLods{5};
+inline constexpr float kDefaultLodReduction{0.5f};
+
+/**
+ * Simplify triangle list by quadric error driven edge collapses. Vertices are collapsed into
+ * existing ones, so result references the same vertex buffer. Mesh borders and attribute seams
+ * (vertices sharing position but differing in other attributes) are preserved.
+ * @param indices The triangle list indices
+ * @param vertices The mesh vertices
+ * @param targetIndexCount The desired number of indices
+ * @param targetError The maximum allowed deviation in object units
+ * @param resultError The output deviation of simplified mesh in object units, optional
+ * @return The simplified triangle list indices
+ */
+[[nodiscard]] std::vector<GLuint>
+simplifyMesh(std::span<const GLuint> indices,
+             std::span<const MeshVertex> vertices,
+             std::size_t targetIndexCount,
+             float targetError = std::numeric_limits<float>::max(),
+             float* resultError = nullptr);
+
+/**
+ * Build chain of levels of detail (at cook or load time). Each level is simplified from the
+ * previous one and appended to the mesh indices, all levels share mesh vertices.
+ * Generation stops early when simplification can't make noticeable progress.
+ * @param mesh The mesh to generate levels of detail for (existing levels except the first
+ *             one are replaced)
+ * @param maxLods The maximum number of levels including the full detail one
+ * @param reduction The ratio of triangle count of next level to previous one
+ * @param maxError The maximum allowed deviation of the coarsest level in object units
+ */
+void
+generateLods(MeshData& mesh,
+             std::size_t maxLods = kDefaultMaxLods,
+             float reduction = kDefaultLodReduction,
+             float maxError = std::numeric_limits<float>::max());
+
+} // namespace glesy
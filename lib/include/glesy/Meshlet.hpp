@@ -0,0 +1,109 @@
+#pragma once
+
+#include "glesy/Api.h"
+#include "glesy/DrawRun.hpp"
+#include "glesy/Frustum.hpp"
+#include "glesy/GeometryHeap.hpp"
+#include "glesy/MeshData.hpp"
+
+#include <glm/vec3.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace glesy {
+
+inline constexpr std::size_t kDefaultMeshletVertices{64};
+inline constexpr std::size_t kDefaultMeshletTriangles{128};
+
+/**
+ * Cluster of spatially close triangles culled as a whole
+ */
+struct Meshlet {
+    /** The offset of the first meshlet index (in indices) */
+    GLuint firstIndex{};
+    GLuint indexCount{};
+    /** Bounding sphere */
+    glm::vec3 center{};
+    float radius{};
+    /** Normal cone, cluster is back facing if viewed within cone around axis (cutoff 1 disables) */
+    glm::vec3 coneAxis{};
+    float coneCutoff{1.0f};
+};
+
+/**
+ * Triangle list reordered into meshlets (indices reference the original mesh vertices)
+ */
+struct MeshletData {
+    std::vector<Meshlet> meshlets;
+    std::vector<GLuint> indices;
+};
+
+/**
+ * Split triangle list into meshlets. Meshlets are grown over adjacent triangles preferring
+ * ones which add the fewest new vertices.
+ * @param indices The triangle list indices
+ * @param vertices The mesh vertices
+ * @param maxVertices The maximum number of unique vertices in meshlet
+ * @param maxTriangles The maximum number of triangles in meshlet
+ * @return The meshlets and reordered indices
+ */
+[[nodiscard]] MeshletData
+buildMeshlets(std::span<const GLuint> indices,
+              std::span<const MeshVertex> vertices,
+              std::size_t maxVertices = kDefaultMeshletVertices,
+              std::size_t maxTriangles = kDefaultMeshletTriangles);
+
+/**
+ * Frustum and normal cone culling of meshlets on CPU.
+ * Meshlet bounds are kept in SoA form and tested four at a time (SSE2, NEON or scalar).
+ */
+class MeshletCuller {
+public:
+    explicit MeshletCuller(std::span<const Meshlet> meshlets);
+
+    /**
+     * Collect visible meshlets (frustum and camera position must be in mesh object space)
+     * @param frustum The view frustum
+     * @param cameraPosition The camera position
+     * @param visible The output indices of visible meshlets (cleared before culling)
+     * @return The number of visible meshlets
+     */
+    std::size_t
+    cull(const Frustum& frustum,
+         const glm::vec3& cameraPosition,
+         std::vector<std::uint32_t>& visible) const;
+
+    [[nodiscard]] std::size_t
+    size() const;
+
+private:
+    std::size_t _count{};
+    std::vector<float> _centerX;
+    std::vector<float> _centerY;
+    std::vector<float> _centerZ;
+    std::vector<float> _radius;
+    std::vector<float> _axisX;
+    std::vector<float> _axisY;
+    std::vector<float> _axisZ;
+    std::vector<float> _cutoff;
+};
+
+/**
+ * Add visible meshlets of geometry heap mesh to the draw run (adjacent meshlets are merged)
+ * @param run The draw run
+ * @param heap The geometry heap holding meshlet indices
+ * @param handle The mesh handle
+ * @param meshlets The mesh meshlets
+ * @param visible The indices of visible meshlets
+ */
+void
+addMeshlets(DrawRun& run,
+            const GeometryHeap& heap,
+            GeometryHeap::Handle handle,
+            std::span<const Meshlet> meshlets,
+            std::span<const std::uint32_t> visible);
+
+} // namespace glesy
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "glesy/Api.h"
+#include "glesy/Buffer.hpp"
+#include "glesy/Shader.hpp"
+#include "glesy/VertexArray.hpp"
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace glesy {
+
+/**
+ * Hardware occlusion culling with GL_ANY_SAMPLES_PASSED queries and conditional rendering.
+ *
+ * Every frame, after occluders (or a depth pre-pass) are drawn, bounding boxes of tested objects
+ * are rasterized against the depth buffer without color and depth writes, each inside its own
+ * query. Heavy object draws are then wrapped into conditional rendering on that query with
+ * GL_QUERY_NO_WAIT, so the GPU skips them when no sample passed and the CPU never waits for
+ * results. Results are also read back a few frames later, without stalling, for statistics.
+ *
+ * Usage per frame:
+ * @code
+ * culler.begin(viewProjection, cameraPosition);
+ * for (object : objects) culler.test(object.id, object.min, object.max);
+ * culler.end();
+ * for (object : objects) {
+ *     culler.beginConditional(object.id);
+ *     object.draw();
+ *     culler.endConditional();
+ * }
+ * @endcode
+ * Proxy pass changes program, vertex array, color/depth masks and face culling, invalidate
+ * @c StateCache after @c end.
+ */
+class OcclusionCuller {
+public:
+    struct Stats {
+        /** Queries issued this frame */
+        std::size_t tested{};
+        /** Objects not tested because camera is inside their bounds */
+        std::size_t skipped{};
+        /** Results read back this frame */
+        std::size_t visible{};
+        std::size_t occluded{};
+        /** Queries reissued before their results were read */
+        std::size_t lost{};
+        /** Draws gated by conditional rendering */
+        std::size_t conditional{};
+    };
+
+    struct ObjectStats {
+        std::uint64_t visible{};
+        std::uint64_t occluded{};
+        /** The frame of the last result showing object visible */
+        std::uint64_t lastVisibleFrame{};
+    };
+
+    /**
+     * @param objects The number of objects
+     * @param latency The number of frames query results may be in flight
+     */
+    explicit OcclusionCuller(std::size_t objects = 0, std::size_t latency = 3);
+
+    OcclusionCuller(const OcclusionCuller&) = delete;
+
+    OcclusionCuller&
+    operator=(const OcclusionCuller&)
+        = delete;
+
+    ~OcclusionCuller();
+
+    /**
+     * Change the number of objects (drops results in flight)
+     */
+    void
+    resize(std::size_t objects);
+
+    [[nodiscard]] std::size_t
+    size() const;
+
+    /**
+     * Start proxy pass: collect finished results and setup proxy drawing state
+     * @param viewProjection The view-projection matrix
+     * @param cameraPosition The camera position in world space
+     */
+    void
+    begin(const glm::mat4& viewProjection, const glm::vec3& cameraPosition);
+
+    /**
+     * Issue occlusion query drawing the world space bounding box of the object
+     */
+    void
+    test(std::uint32_t object, const glm::vec3& minimum, const glm::vec3& maximum);
+
+    /**
+     * Finish proxy pass and restore color and depth writes
+     */
+    void
+    end();
+
+    /**
+     * Start conditional rendering on the object query issued this frame
+     * @return @c false if object was not tested this frame (draws are not gated)
+     */
+    bool
+    beginConditional(std::uint32_t object);
+
+    void
+    endConditional();
+
+    [[nodiscard]] const Stats&
+    stats() const;
+
+    [[nodiscard]] const ObjectStats&
+    objectStats(std::uint32_t object) const;
+
+private:
+    struct PendingQuery {
+        std::uint32_t object{};
+        std::uint32_t slot{};
+        std::uint64_t frame{};
+    };
+
+    void
+    collect();
+
+    [[nodiscard]] GLuint
+    query(std::uint32_t object, std::uint32_t slot) const;
+
+private:
+    std::size_t _latency{};
+    std::size_t _objects{};
+    std::vector<GLuint> _queries;
+    // Frame the query in object slot was issued at, 0 when it has no pending result
+    std::vector<std::uint64_t> _issuedFrames;
+    std::vector<ObjectStats> _objectStats;
+    std::deque<PendingQuery> _pending;
+    std::uint64_t _frame{};
+    glm::vec3 _cameraPosition{};
+    bool _conditional{false};
+    Stats _stats;
+
+    Shader _shader;
+    Buffer _vertices{GL_ARRAY_BUFFER};
+    Buffer _indices{GL_ELEMENT_ARRAY_BUFFER};
+    VertexArray _vertexArray;
+    GLint _viewProjectionLocation{-1};
+    GLint _minimumLocation{-1};
+    GLint _maximumLocation{-1};
+};
+
+} // namespace glesy
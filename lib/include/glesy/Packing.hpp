@@ -0,0 +1,99 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+namespace glesy {
+
+namespace detail {
+
+constexpr std::int32_t
+roundToInt(const float value)
+{
+    return static_cast<std::int32_t>(value + ((value >= 0.0f) ? 0.5f : -0.5f));
+}
+
+} // namespace detail
+
+/**
+ * Convert single precision float into half float (GL_HALF_FLOAT) using round-to-nearest-even
+ */
+constexpr std::uint16_t
+packHalf(const float value)
+{
+    const auto bits = std::bit_cast<std::uint32_t>(value);
+    const std::uint32_t sign = (bits >> 16U) & 0x8000U;
+    const std::uint32_t absBits = bits & 0x7FFFFFFFU;
+
+    if (absBits >= 0x7F800000U) {
+        // Infinity or NaN (keep NaN quiet)
+        return static_cast<std::uint16_t>(sign | 0x7C00U | ((absBits > 0x7F800000U) ? 0x200U : 0U));
+    }
+    if (absBits >= 0x477FF000U) {
+        // Rounds to infinity (greater than 65504 after rounding)
+        return static_cast<std::uint16_t>(sign | 0x7C00U);
+    }
+    if (absBits < 0x38800000U) {
+        // Subnormal half or zero
+        if (absBits < 0x33000000U) {
+            return static_cast<std::uint16_t>(sign);
+        }
+        const std::uint32_t mantissa = (absBits & 0x7FFFFFU) | 0x800000U;
+        const std::uint32_t shift = 126U - (absBits >> 23U);
+        const std::uint32_t half = mantissa >> shift;
+        const std::uint32_t rest = mantissa & ((1U << shift) - 1U);
+        const std::uint32_t halfway = 1U << (shift - 1U);
+        const bool roundUp = (rest > halfway) or (rest == halfway and (half & 1U) != 0U);
+        return static_cast<std::uint16_t>(sign | (half + (roundUp ? 1U : 0U)));
+    }
+
+    const std::uint32_t half = (((absBits >> 23U) - 112U) << 10U) | ((absBits >> 13U) & 0x3FFU);
+    const std::uint32_t rest = absBits & 0x1FFFU;
+    const bool roundUp = (rest > 0x1000U) or (rest == 0x1000U and (half & 1U) != 0U);
+    return static_cast<std::uint16_t>(sign | (half + (roundUp ? 1U : 0U)));
+}
+
+/**
+ * Convert float in [-1, 1] range into signed normalized short (GL_SHORT normalized)
+ */
+constexpr std::int16_t
+packSnorm16(const float value)
+{
+    return static_cast<std::int16_t>(detail::roundToInt(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+}
+
+/**
+ * Convert float in [0, 1] range into unsigned normalized short (GL_UNSIGNED_SHORT normalized)
+ */
+constexpr std::uint16_t
+packUnorm16(const float value)
+{
+    return static_cast<std::uint16_t>(detail::roundToInt(std::clamp(value, 0.0f, 1.0f) * 65535.0f));
+}
+
+/**
+ * Convert float in [0, 1] range into unsigned normalized byte (GL_UNSIGNED_BYTE normalized)
+ */
+constexpr std::uint8_t
+packUnorm8(const float value)
+{
+    return static_cast<std::uint8_t>(detail::roundToInt(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+}
+
+/**
+ * Pack four floats in [-1, 1] range into signed normalized GL_INT_2_10_10_10_REV value
+ * (typically used for normals and tangents)
+ */
+constexpr std::uint32_t
+packSnorm1010102(const float x, const float y, const float z, const float w = 0.0f)
+{
+    const auto snorm = [](const float value, const float scale, const std::uint32_t mask) {
+        const std::int32_t rounded = detail::roundToInt(std::clamp(value, -1.0f, 1.0f) * scale);
+        return static_cast<std::uint32_t>(rounded) & mask;
+    };
+    return snorm(x, 511.0f, 0x3FFU) | (snorm(y, 511.0f, 0x3FFU) << 10U)
+           | (snorm(z, 511.0f, 0x3FFU) << 20U) | (snorm(w, 1.0f, 0x3U) << 30U);
+}
+
+} // namespace glesy
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace glesy {
+
+/**
+ * Persistent pool of worker threads used by data-parallel algorithms (loading, culling,
+ * transform update, binning). Calling thread participates in the work and blocks until
+ * all tasks are done. Nested calls from inside a task run sequentially.
+ */
+class ThreadPool {
+public:
+    /**
+     * @param workers The number of worker threads (besides calling thread)
+     */
+    explicit ThreadPool(std::size_t workers);
+
+    ThreadPool(const ThreadPool&) = delete;
+
+    ThreadPool&
+    operator=(const ThreadPool&)
+        = delete;
+
+    ~ThreadPool();
+
+    /**
+     * Get shared pool sized by the number of hardware threads
+     */
+    static ThreadPool&
+    instance();
+
+    /**
+     * Get the number of threads executing tasks (workers and calling thread)
+     */
+    [[nodiscard]] std::size_t
+    concurrency() const;
+
+    /**
+     * Execute fn(taskIndex) for every task index in [0, tasks)
+     * @param tasks The number of tasks
+     * @param fn The task function
+     */
+    template<typename Fn>
+    void
+    run(const std::size_t tasks, Fn&& fn)
+    {
+        using Callable = std::remove_reference_t<Fn>;
+        execute(
+            tasks,
+            [](void* context, const std::size_t task) { (*static_cast<Callable*>(context))(task); },
+            const_cast<void*>(static_cast<const void*>(&fn)));
+    }
+
+private:
+    using TaskFn = void (*)(void*, std::size_t);
+
+    void
+    execute(std::size_t tasks, TaskFn fn, void* context);
+
+    void
+    work();
+
+    bool
+    process();
+
+private:
+    std::vector<std::jthread> _workers;
+    std::mutex _submitGuard;
+    std::mutex _guard;
+    std::condition_variable _wakeUp;
+    std::condition_variable _done;
+    TaskFn _fn{};
+    void* _context{};
+    std::size_t _tasks{};
+    std::size_t _next{};
+    std::size_t _pending{};
+    std::size_t _generation{};
+    std::exception_ptr _error;
+    bool _stop{false};
+};
+
+/**
+ * Split [0, count) range into contiguous chunks of at least @p grain items and call
+ * fn(begin, end) for each chunk in parallel
+ */
+template<typename Fn>
+void
+parallelFor(const std::size_t count, const std::size_t grain, Fn&& fn)
+{
+    if (count == 0) {
+        return;
+    }
+    auto& pool = ThreadPool::instance();
+    const std::size_t chunks
+        = std::clamp<std::size_t>((count + grain - 1) / std::max<std::size_t>(grain, 1),
+                                  1,
+                                  pool.concurrency());
+    const std::size_t chunkSize = (count + chunks - 1) / chunks;
+    pool.run(chunks, [&](const std::size_t chunk) {
+        const std::size_t begin = chunk * chunkSize;
+        const std::size_t end = std::min(count, begin + chunkSize);
+        if (begin < end) {
+            fn(begin, end);
+        }
+    });
+}
+
+} // namespace glesy
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "glesy/Api.h"
+#include "glesy/RenderTarget.hpp"
+#include "glesy/RenderTargetPool.hpp"
+#include "glesy/Shader.hpp"
+#include "glesy/VertexArray.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace glesy {
+
+/**
+ * Full-screen effect declared as GLSL snippet. The snippet defines the function named after the
+ * effect and any uniforms or helpers it needs (prefixed with the effect name, as snippets share
+ * one program). The @c uSource sampler and @c uTexelSize uniform are declared by the stack.
+ *
+ * Per-pixel effects define @c "vec4 name(vec4 color, vec2 uv)", neighborhood effects sample the
+ * source themselves and define @c "vec4 name(sampler2D source, vec2 uv)".
+ */
+struct PostEffect {
+    std::string name;
+    std::string source;
+    /** The effect reads neighboring pixels (blur, FXAA), it starts a new pass */
+    bool neighborhood{false};
+    /** Set effect uniforms, called with program in use */
+    std::function<void(const Shader&)> setup;
+};
+
+/**
+ * Chain of full-screen effects. Consecutive per-pixel effects are fused into one generated
+ * program, so the chain costs one framebuffer read and write per neighborhood effect instead
+ * of one per effect. Generated programs are cached by the combination of effects.
+ *
+ * Intermediate targets come from the pool and are released right after being read.
+ */
+class PostProcessStack {
+public:
+    struct Stats {
+        std::size_t effects{};
+        std::size_t passes{};
+        std::size_t programs{};
+    };
+
+    /**
+     * @param pool The pool of intermediate targets
+     * @param format The internal format of intermediate targets
+     */
+    explicit PostProcessStack(RenderTargetPool& pool, GLenum format = GL_RGBA16F);
+
+    PostProcessStack(const PostProcessStack&) = delete;
+
+    PostProcessStack&
+    operator=(const PostProcessStack&)
+        = delete;
+
+    /**
+     * Append effect to the end of the chain
+     * @throw std::invalid_argument if name is empty or already used
+     */
+    void
+    add(PostEffect effect);
+
+    /**
+     * Remove effect and programs generated with it
+     */
+    void
+    remove(std::string_view name);
+
+    void
+    setEnabled(std::string_view name, bool enabled);
+
+    [[nodiscard]] bool
+    enabled(std::string_view name) const;
+
+    /**
+     * Run enabled effects over the input.
+     * Depth test and blending are disabled, the output framebuffer stays bound.
+     * @param input The source color target
+     * @param framebuffer The output framebuffer (0 for default)
+     * @param width The output width
+     * @param height The output height
+     */
+    void
+    apply(const RenderTarget& input, GLuint framebuffer, GLsizei width, GLsizei height);
+
+    [[nodiscard]] Stats
+    stats() const;
+
+private:
+    struct Entry {
+        PostEffect effect;
+        bool enabled{true};
+    };
+
+    struct Pass {
+        std::vector<std::size_t> effects;
+        const Shader* shader{};
+    };
+
+    void
+    build();
+
+    [[nodiscard]] const Shader&
+    program(std::span<const std::size_t> effects);
+
+    [[nodiscard]] std::vector<Entry>::iterator
+    find(std::string_view name);
+
+    [[nodiscard]] std::vector<Entry>::const_iterator
+    find(std::string_view name) const;
+
+private:
+    RenderTargetPool& _pool;
+    GLenum _format{};
+    std::vector<Entry> _entries;
+    std::vector<Pass> _passes;
+    bool _dirty{true};
+    std::map<std::string, std::unique_ptr<Shader>, std::less<>> _programs;
+    VertexArray _vertexArray;
+};
+
+} // namespace glesy
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "glesy/Api.h"
+#include "glesy/VertexFormat.hpp"
+
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace glesy {
+
+struct ProgramAttribute {
+    std::string name;
+    GLint location{-1};
+    GLenum type{};
+    GLint size{};
+};
+
+struct ProgramUniform {
+    std::string name;
+    GLint location{-1};
+    GLenum type{};
+    GLint size{};
+    GLint blockIndex{-1};
+    GLint blockOffset{-1};
+};
+
+struct ProgramUniformBlock {
+    std::string name;
+    GLuint index{};
+    GLint dataSize{};
+    GLint binding{};
+    std::vector<GLuint> uniforms;
+};
+
+/**
+ * Immutable description of the linked program interface (active attributes, uniforms and
+ * uniform blocks) queried once right after linking.
+ */
+class ProgramInterface {
+public:
+    ProgramInterface() = default;
+
+    /**
+     * Query active attributes, uniforms and uniform blocks of the linked program
+     * @param program The linked program object handle
+     * @return The program interface description
+     */
+    static ProgramInterface
+    reflect(GLuint program);
+
+    [[nodiscard]] const std::vector<ProgramAttribute>&
+    attributes() const;
+
+    [[nodiscard]] const std::vector<ProgramUniform>&
+    uniforms() const;
+
+    [[nodiscard]] const std::vector<ProgramUniformBlock>&
+    uniformBlocks() const;
+
+    [[nodiscard]] const ProgramAttribute*
+    findAttribute(std::string_view name) const;
+
+    [[nodiscard]] const ProgramUniform*
+    findUniform(std::string_view name) const;
+
+    [[nodiscard]] const ProgramUniformBlock*
+    findUniformBlock(std::string_view name) const;
+
+    /**
+     * Get location of the default block uniform
+     * @param name The uniform name (array uniforms without "[0]" suffix or with element index)
+     * @return The uniform location, -1 if uniform is not active
+     */
+    [[nodiscard]] GLint
+    uniformLocation(std::string_view name) const;
+
+    /**
+     * Check that vertex format feeds every active attribute with compatible data.
+     * Mismatches are printed to output log.
+     * @warning Slow operation, do not use in drawing routine
+     * @param format The vertex format to check
+     * @return @c true if format matches program inputs, @c false - otherwise
+     */
+    [[nodiscard]] bool
+    matches(const VertexFormat& format) const;
+
+private:
+    GLuint _program{};
+    std::vector<ProgramAttribute> _attributes;
+    std::vector<ProgramUniform> _uniforms;
+    std::vector<ProgramUniformBlock> _uniformBlocks;
+    std::map<std::string, std::size_t, std::less<>> _uniformsByName;
+};
+
+} // namespace glesy
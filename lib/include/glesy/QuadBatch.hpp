@@ -0,0 +1,137 @@
+#pragma once
+
+#include "glesy/Api.h"
+#include "glesy/Buffer.hpp"
+#include "glesy/Shader.hpp"
+#include "glesy/StreamBuffer.hpp"
+#include "glesy/VertexArray.hpp"
+#include "glesy/VertexLayout.hpp"
+
+#include <glm/mat3x3.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace glesy {
+
+/**
+ * Batched renderer of textured quads (sprites, glyphs, UI elements).
+ *
+ * Quads are transformed on CPU and appended into the streaming vertex buffer, all batches share
+ * one static index buffer. Batch is split only when program or texture changes (or batch is
+ * full), each batch is drawn with single draw call.
+ *
+ * Program must declare inputs: "layout(location = 0) in vec2" (position),
+ * "layout(location = 1) in vec2" (texture coordinates) and "layout(location = 2) in vec4" (color).
+ * Texture is bound to unit 0.
+ */
+class QuadBatch {
+public:
+    struct Vertex {
+        glm::vec2 position;
+        glm::vec2 texCoord;
+        glm::u8vec4 color;
+    };
+
+    using Layout = VertexLayout<FloatAttr<0, 2>, FloatAttr<1, 2>, UNorm8Attr<2, 4>>;
+
+    struct Stats {
+        std::size_t draws{};
+        std::size_t quads{};
+
+        [[nodiscard]] float
+        quadsPerDraw() const;
+    };
+
+    /**
+     * @param maxQuads The maximum number of quads drawn by single draw call
+     * @param streamCapacity The capacity of streaming vertex buffer in bytes
+     */
+    explicit QuadBatch(std::size_t maxQuads = 16384, GLsizeiptr streamCapacity = 8 * 1024 * 1024);
+
+    /**
+     * Start new frame (resets per-frame counters)
+     */
+    void
+    begin();
+
+    /**
+     * Append quad into the batch
+     * @param shader The program to draw quad with
+     * @param texture The texture object handle
+     * @param transform The transform of unit quad [0, 1]x[0, 1] into destination space
+     * @param uvRect The texture coordinates rectangle (u0, v0, u1, v1)
+     * @param color The color quad is modulated by
+     */
+    void
+    draw(const Shader& shader,
+         GLuint texture,
+         const glm::mat3& transform,
+         const glm::vec4& uvRect = {0.0f, 0.0f, 1.0f, 1.0f},
+         const glm::u8vec4& color = {255, 255, 255, 255});
+
+    /**
+     * Append axis-aligned quad into the batch
+     * @param shader The program to draw quad with
+     * @param texture The texture object handle
+     * @param rect The destination rectangle (x, y, width, height)
+     * @param uvRect The texture coordinates rectangle (u0, v0, u1, v1)
+     * @param color The color quad is modulated by
+     */
+    void
+    draw(const Shader& shader,
+         GLuint texture,
+         const glm::vec4& rect,
+         const glm::vec4& uvRect = {0.0f, 0.0f, 1.0f, 1.0f},
+         const glm::u8vec4& color = {255, 255, 255, 255});
+
+    /**
+     * Draw pending quads
+     */
+    void
+    flush();
+
+    /**
+     * Draw pending quads and finish the frame
+     */
+    void
+    end();
+
+    /**
+     * Get counters of the current frame
+     */
+    [[nodiscard]] const Stats&
+    stats() const;
+
+    /**
+     * Get counters of the last finished frame
+     */
+    [[nodiscard]] const Stats&
+    lastFrameStats() const;
+
+private:
+    void
+    bind(const Shader& shader, GLuint texture);
+
+    void
+    append(const glm::vec2 (&corners)[4], const glm::vec4& uvRect, const glm::u8vec4& color);
+
+private:
+    std::size_t _maxQuads{};
+    GLenum _indexType{};
+    Buffer _indices;
+    StreamBuffer _vertices;
+    VertexArray _vertexArray;
+    std::vector<Vertex> _pending;
+    /** The serials of shaders validated against quad vertex layout */
+    std::vector<std::uint64_t> _validShaders;
+    GLuint _program{};
+    GLuint _texture{};
+    Stats _stats;
+    Stats _lastFrameStats;
+};
+
+} // namespace glesy
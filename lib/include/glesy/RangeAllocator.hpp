@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <set>
+#include <utility>
+
+namespace glesy {
+
+/**
+ * Free-list allocator of ranges inside linear storage (e.g. sub-ranges of GPU buffer).
+ * Allocation picks the best fitting free block, released ranges are coalesced with
+ * adjacent free blocks.
+ */
+class RangeAllocator {
+public:
+    static constexpr std::size_t kInvalidOffset{~std::size_t{0}};
+
+    explicit RangeAllocator(std::size_t capacity = 0);
+
+    /**
+     * Allocate range of given size
+     * @param size The size of range in storage units
+     * @return The offset of allocated range, kInvalidOffset if no free block is large enough
+     */
+    [[nodiscard]] std::size_t
+    allocate(std::size_t size);
+
+    /**
+     * Release previously allocated range
+     * @param offset The offset of range
+     * @param size The size of range
+     */
+    void
+    free(std::size_t offset, std::size_t size);
+
+    /**
+     * Extend managed storage, new space is appended to the end
+     * @param capacity The new capacity (not less than current one)
+     */
+    void
+    grow(std::size_t capacity);
+
+    /**
+     * Release all ranges
+     */
+    void
+    reset();
+
+    [[nodiscard]] std::size_t
+    capacity() const;
+
+    [[nodiscard]] std::size_t
+    used() const;
+
+    [[nodiscard]] std::size_t
+    largestFreeBlock() const;
+
+    /**
+     * Get fragmentation of free space
+     * @return 0 if all free space is a single block, values near 1 for scattered free space
+     */
+    [[nodiscard]] float
+    fragmentation() const;
+
+private:
+    void
+    insertFree(std::size_t offset, std::size_t size);
+
+    void
+    eraseFree(std::map<std::size_t, std::size_t>::iterator it);
+
+private:
+    std::size_t _capacity{};
+    std::size_t _used{};
+    std::map<std::size_t, std::size_t> _freeByOffset;
+    std::set<std::pair<std::size_t, std::size_t>> _freeBySize;
+};
+
+} // namespace glesy
@@ -0,0 +1,195 @@
+#pragma once
+
+#include "glesy/Api.h"
+#include "glesy/RenderTarget.hpp"
+#include "glesy/RenderTargetPool.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace glesy {
+
+/**
+ * Frame render graph. Passes declare which render targets they read and write, the graph orders
+ * them by dependencies, culls passes not contributing to the frame output and allocates transient
+ * targets from the pool only for their lifetime, so targets with disjoint lifetimes share memory.
+ *
+ * The graph is rebuilt every frame: declare resources and passes, call @c compile, @c execute
+ * and @c reset.
+ */
+class RenderGraph {
+public:
+    using Resource = std::uint32_t;
+
+    static constexpr Resource kInvalidResource{~Resource{}};
+
+    /**
+     * Declares pass inputs and outputs during @c addPass
+     */
+    class PassBuilder {
+    public:
+        /**
+         * Sample the resource in the pass
+         */
+        void
+        read(Resource resource);
+
+        /**
+         * Render into the resource, depth formats are attached as depth buffer
+         */
+        void
+        write(Resource resource);
+
+        /**
+         * Keep the pass even if its outputs are not used (e.g. it writes buffers or queries)
+         */
+        void
+        sideEffect();
+
+    private:
+        friend class RenderGraph;
+
+        PassBuilder(RenderGraph& graph, std::size_t pass);
+
+        RenderGraph& _graph;
+        std::size_t _pass;
+    };
+
+    /**
+     * Gives pass execution access to physical resources
+     */
+    class PassContext {
+    public:
+        /**
+         * Get texture of the resource read or written by the pass
+         */
+        [[nodiscard]] GLuint
+        texture(Resource resource) const;
+
+        /**
+         * Bind texture of the resource to the texture unit
+         */
+        void
+        bindTexture(GLuint unit, Resource resource) const;
+
+        [[nodiscard]] GLsizei
+        width() const;
+
+        [[nodiscard]] GLsizei
+        height() const;
+
+    private:
+        friend class RenderGraph;
+
+        PassContext(const RenderGraph& graph, GLsizei width, GLsizei height);
+
+        const RenderGraph& _graph;
+        GLsizei _width{};
+        GLsizei _height{};
+    };
+
+    using SetupFunction = std::function<void(PassBuilder&)>;
+    using ExecuteFunction = std::function<void(const PassContext&)>;
+
+    struct Stats {
+        std::size_t passes{};
+        std::size_t culledPasses{};
+        std::size_t transientTargets{};
+        std::size_t physicalTargets{};
+    };
+
+    explicit RenderGraph(RenderTargetPool& pool);
+
+    /**
+     * Declare transient render target living only inside the frame
+     */
+    Resource
+    createTarget(std::string name, const RenderTargetDesc& desc);
+
+    /**
+     * Declare persistent render target owned by the caller, passes writing it are never culled
+     */
+    Resource
+    importTarget(std::string name, RenderTarget& target);
+
+    /**
+     * Declare default framebuffer, passes writing it are never culled
+     */
+    Resource
+    importBackbuffer(GLsizei width, GLsizei height);
+
+    /**
+     * Add pass to the graph
+     * @param name The pass name used in diagnostics
+     * @param setup The function declaring pass resources, called immediately
+     * @param execute The function issuing pass commands with its framebuffer bound
+     */
+    void
+    addPass(std::string name, const SetupFunction& setup, ExecuteFunction execute);
+
+    /**
+     * Order and cull passes and compute resource lifetimes
+     * @throw std::runtime_error if pass dependencies contain a cycle
+     */
+    void
+    compile();
+
+    /**
+     * Execute compiled passes
+     */
+    void
+    execute();
+
+    /**
+     * Remove all passes and resources to build the next frame
+     */
+    void
+    reset();
+
+    [[nodiscard]] const Stats&
+    stats() const;
+
+private:
+    enum class Kind { Transient, Imported, Backbuffer };
+
+    struct ResourceNode {
+        std::string name;
+        Kind kind{Kind::Transient};
+        RenderTargetDesc desc;
+        RenderTarget* target{};
+        std::vector<std::size_t> writers;
+        std::size_t firstUse{};
+        std::size_t lastUse{};
+        bool used{false};
+    };
+
+    struct PassNode {
+        std::string name;
+        ExecuteFunction execute;
+        std::vector<Resource> reads;
+        std::vector<Resource> writes;
+        bool sideEffect{false};
+        bool alive{false};
+    };
+
+    void
+    checkResource(Resource resource) const;
+
+    [[nodiscard]] std::vector<std::size_t>
+    dependencies(std::size_t pass) const;
+
+    void
+    bindOutputs(const PassNode& pass, GLsizei& width, GLsizei& height);
+
+private:
+    RenderTargetPool& _pool;
+    std::vector<ResourceNode> _resources;
+    std::vector<PassNode> _passes;
+    std::vector<std::size_t> _order;
+    Stats _stats;
+};
+
+} // namespace glesy
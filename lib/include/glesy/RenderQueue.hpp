@@ -0,0 +1,137 @@
+#pragma once
+
+#include "glesy/Api.h"
+#include "glesy/StateCache.hpp"
+
+#include <glm/mat4x4.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace glesy {
+
+/** Uniform block binding point used for material uniform buffer ranges of render commands */
+inline constexpr GLuint kMaterialBlockBinding{0};
+
+/**
+ * Fields of the render command sort key. Key layout from the most significant bits:
+ * layer (4), translucency (1), then for opaque commands program (11), material (12),
+ * texture (12) and depth (24, front to back); for translucent commands depth goes right after
+ * translucency bit (back to front) followed by program, material and texture.
+ */
+struct RenderKeyFields {
+    std::uint32_t layer{};
+    bool translucent{false};
+    /** Small identifiers of program, material and texture (truncated to key bit widths) */
+    std::uint32_t program{};
+    std::uint32_t material{};
+    std::uint32_t texture{};
+    /** Normalized view depth in [0, 1] range */
+    float depth{};
+};
+
+/**
+ * Pack sort key fields into 64-bit sort key
+ */
+[[nodiscard]] std::uint64_t
+makeRenderKey(const RenderKeyFields& fields);
+
+/**
+ * Check translucency bit of the sort key
+ */
+[[nodiscard]] bool
+isTranslucentKey(std::uint64_t key);
+
+/**
+ * Self-contained draw command (no pointers, no GL calls on recording)
+ */
+struct RenderCommand {
+    std::uint64_t key{};
+    GLuint program{};
+    GLuint vertexArray{};
+    /** The texture bound to unit 0 as GL_TEXTURE_2D (0 if not used) */
+    GLuint texture{};
+    /** The uniform buffer range bound to kMaterialBlockBinding (0 if not used) */
+    GLuint materialBuffer{};
+    GLintptr materialOffset{};
+    GLsizeiptr materialSize{};
+    /** The location of mat4 model transform uniform (-1 if not used) */
+    GLint modelLocation{-1};
+    glm::mat4 model{1.0f};
+    GLenum primitive{GL_TRIANGLES};
+    GLenum indexType{GL_UNSIGNED_INT};
+    GLsizei indexCount{};
+    /** The offset in bytes of the first index in vertex array index buffer */
+    GLintptr indexOffset{};
+    GLint baseVertex{};
+    GLsizei instanceCount{1};
+};
+
+/**
+ * Per-frame queue of draw commands sorted by 64-bit keys with radix sort. Sorting groups
+ * commands by state (fewer program and texture switches) and orders opaque ones front to back
+ * (less overdraw) and translucent ones back to front (correct blending).
+ */
+class RenderQueue {
+public:
+    struct Stats {
+        std::size_t commands{};
+        /** The number of issued draw calls (empty commands are skipped) */
+        std::size_t drawCalls{};
+        std::size_t stateChanges{};
+    };
+
+    void
+    reserve(std::size_t count);
+
+    void
+    push(const RenderCommand& command);
+
+    /**
+     * Append commands (e.g. recorded by another thread)
+     */
+    void
+    append(std::span<const RenderCommand> commands);
+
+    /**
+     * Sort commands by keys (stable, linear time)
+     */
+    void
+    sort();
+
+    /**
+     * Sort (if not yet sorted) and execute commands through the state cache
+     * @param state The state cache of the current context
+     */
+    void
+    execute(StateCache& state);
+
+    void
+    clear();
+
+    [[nodiscard]] std::span<const RenderCommand>
+    commands() const;
+
+    [[nodiscard]] std::size_t
+    size() const;
+
+    [[nodiscard]] const Stats&
+    stats() const;
+
+private:
+    struct SortItem {
+        std::uint64_t key{};
+        std::uint32_t index{};
+    };
+
+private:
+    std::vector<RenderCommand> _commands;
+    std::vector<SortItem> _items;
+    std::vector<SortItem> _scratch;
+    bool _sorted{true};
+    Stats _stats;
+};
+
+} // namespace glesy
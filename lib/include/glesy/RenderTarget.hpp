@@ -0,0 +1,107 @@
+#pragma once
+
+#include "glesy/Api.h"
+
+#include <cstddef>
+
+namespace glesy {
+
+struct RenderTargetDesc {
+    GLsizei width{};
+    GLsizei height{};
+    /** The sized internal format (e.g. GL_RGBA8, GL_RGBA16F, GL_DEPTH24_STENCIL8) */
+    GLenum internalFormat{GL_RGBA8};
+
+    bool
+    operator==(const RenderTargetDesc&) const
+        = default;
+
+    [[nodiscard]] bool
+    isDepth() const;
+
+    [[nodiscard]] bool
+    hasStencil() const;
+
+    /**
+     * Get approximate size of texture storage in bytes
+     */
+    [[nodiscard]] std::size_t
+    byteSize() const;
+};
+
+/**
+ * Owns 2D texture usable as framebuffer attachment and sampled afterwards
+ */
+class RenderTarget {
+public:
+    explicit RenderTarget(const RenderTargetDesc& desc);
+
+    RenderTarget(RenderTarget&& other) noexcept;
+
+    RenderTarget&
+    operator=(RenderTarget&& other) noexcept;
+
+    ~RenderTarget();
+
+    [[nodiscard]] GLuint
+    id() const;
+
+    [[nodiscard]] const RenderTargetDesc&
+    desc() const;
+
+private:
+    GLuint _id{};
+    RenderTargetDesc _desc;
+};
+
+/**
+ * Owns framebuffer object
+ */
+class Framebuffer {
+public:
+    Framebuffer();
+
+    Framebuffer(Framebuffer&& other) noexcept;
+
+    Framebuffer&
+    operator=(Framebuffer&& other) noexcept;
+
+    ~Framebuffer();
+
+    [[nodiscard]] GLuint
+    id() const;
+
+    void
+    bind() const;
+
+    /**
+     * Bind default framebuffer
+     */
+    static void
+    unbind();
+
+    /**
+     * Attach render target (depth formats go to depth or depth-stencil attachment point)
+     * @param colorIndex The index of color attachment (ignored for depth formats)
+     * @param target The render target
+     */
+    void
+    attach(GLuint colorIndex, const RenderTarget& target);
+
+    /**
+     * Set draw buffers to the first @p count color attachments
+     */
+    void
+    setDrawBuffers(GLsizei count);
+
+    /**
+     * Check framebuffer completeness (status is printed to output log on failure)
+     */
+    [[nodiscard]] bool
+    complete() const;
+
+private:
+    GLuint _id{};
+};
+
+} // namespace glesy
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "glesy/Api.h"
+#include "glesy/RenderTarget.hpp"
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace glesy {
+
+/**
+ * Persistent pool of render targets and framebuffers. Targets released during the frame are
+ * handed out again to later passes (memory aliasing), and are kept between frames, so textures
+ * are not created every frame. Targets idle for too long are destroyed.
+ */
+class RenderTargetPool {
+public:
+    /**
+     * @param budget The memory budget in bytes (0 for unlimited), idle targets are evicted to fit
+     */
+    explicit RenderTargetPool(std::size_t budget = 0);
+
+    RenderTargetPool(const RenderTargetPool&) = delete;
+
+    RenderTargetPool&
+    operator=(const RenderTargetPool&)
+        = delete;
+
+    /**
+     * Get render target of given description not used by anyone else
+     */
+    [[nodiscard]] RenderTarget&
+    acquire(const RenderTargetDesc& desc);
+
+    /**
+     * Return render target into the pool (may be acquired again in the same frame)
+     */
+    void
+    release(const RenderTarget& target);
+
+    /**
+     * Get cached framebuffer with given attachments
+     * @param colors The color attachments
+     * @param depth The depth (or depth-stencil) attachment, optional
+     */
+    [[nodiscard]] Framebuffer&
+    framebuffer(std::span<const RenderTarget* const> colors, const RenderTarget* depth);
+
+    /**
+     * Finish frame and destroy targets not used for given number of frames
+     */
+    void
+    endFrame(std::size_t maxIdleFrames = 60);
+
+    [[nodiscard]] std::size_t
+    allocatedBytes() const;
+
+    [[nodiscard]] std::size_t
+    targetCount() const;
+
+private:
+    struct Entry {
+        std::unique_ptr<RenderTarget> target;
+        bool inUse{false};
+        std::size_t lastUsedFrame{};
+    };
+
+    void
+    evict(std::size_t index);
+
+private:
+    std::size_t _budget{};
+    std::size_t _allocated{};
+    std::size_t _frame{};
+    std::vector<Entry> _entries;
+    std::map<std::vector<GLuint>, Framebuffer> _framebuffers;
+};
+
+} // namespace glesy
@@ -1,8 +1,14 @@
 #pragma once
 
 #include "glesy/Api.h"
+#include "glesy/Buffer.hpp"
+#include "glesy/ProgramInterface.hpp"
+#include "glesy/VertexArray.hpp"
+#include "glesy/VertexFormat.hpp"
 
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace glesy {
 
@@ -10,11 +16,44 @@ class Shader {
 public:
     Shader(const GLchar* vertexShaderSrc, const GLchar* fragShaderSrc);
 
+    Shader(const Shader&) = delete;
+
+    Shader&
+    operator=(const Shader&)
+        = delete;
+
     ~Shader();
 
     [[nodiscard]] GLuint
     id() const;
 
+    /**
+     * Get process-wide unique shader serial number, never reused unlike OpenGL program names
+     */
+    [[nodiscard]] std::uint64_t
+    serial() const;
+
+    /**
+     * Get program interface reflected right after linking
+     */
+    [[nodiscard]] const ProgramInterface&
+    interface() const;
+
+    /**
+     * Get vertex array object which feeds this program from given buffers.
+     * Vertex array objects are created and validated against program interface
+     * on first request and cached afterward (keyed by buffer serials, so recycled
+     * OpenGL buffer names never hit stale entries).
+     * @param vertexBuffer The vertex buffer
+     * @param indexBuffer The index buffer (@c nullptr if not used)
+     * @param format The layout of vertex buffer
+     * @return The vertex array object handle
+     */
+    [[nodiscard]] GLuint
+    vertexArray(const Buffer& vertexBuffer,
+                const Buffer* indexBuffer,
+                const VertexFormat& format) const;
+
     void
     use() const;
 
@@ -28,7 +67,17 @@ public:
     setFloat(const std::string& name, float value) const;
 
 private:
+    struct CachedVertexArray {
+        std::uint64_t vertexBuffer{};
+        std::uint64_t indexBuffer{};
+        VertexFormat format;
+        VertexArray vertexArray;
+    };
+
     GLuint _program{};
+    std::uint64_t _serial{};
+    ProgramInterface _interface;
+    mutable std::vector<CachedVertexArray> _vertexArrays;
 };
 
-} // namespace glesy
\ No newline at end of file
+} // namespace glesy
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "glesy/Api.h"
+
+#include <array>
+#include <cstddef>
+
+namespace glesy {
+
+/**
+ * Shadow copy of frequently changed OpenGL state. Redundant state changes are filtered out
+ * before reaching the driver. Call invalidate() after code bypassing the cache touched state.
+ */
+class StateCache {
+public:
+    static constexpr std::size_t kTextureUnits{16};
+    static constexpr std::size_t kUniformBufferBindings{16};
+
+    struct Stats {
+        /** The number of state changes issued to OpenGL */
+        std::size_t changes{};
+        /** The number of redundant state changes filtered out */
+        std::size_t skipped{};
+    };
+
+    StateCache();
+
+    void
+    useProgram(GLuint program);
+
+    void
+    bindVertexArray(GLuint vertexArray);
+
+    void
+    bindTexture(GLuint unit, GLenum target, GLuint texture);
+
+    void
+    bindUniformBuffer(GLuint binding, GLuint buffer, GLintptr offset, GLsizeiptr size);
+
+    void
+    setBlend(bool enabled);
+
+    void
+    setBlendFunc(GLenum source, GLenum destination);
+
+    void
+    setDepthTest(bool enabled);
+
+    void
+    setDepthWrite(bool enabled);
+
+    void
+    setCullFace(bool enabled);
+
+    /**
+     * Forget cached state, next changes are issued unconditionally
+     */
+    void
+    invalidate();
+
+    [[nodiscard]] const Stats&
+    stats() const;
+
+    void
+    resetStats();
+
+private:
+    enum class Flag { Unknown, Disabled, Enabled };
+
+    struct TextureBinding {
+        GLenum target{};
+        GLuint texture{};
+        bool known{false};
+    };
+
+    struct BufferRange {
+        GLuint buffer{};
+        GLintptr offset{};
+        GLsizeiptr size{};
+        bool known{false};
+    };
+
+    bool
+    update(bool changed);
+
+    void
+    setCapability(Flag& flag, GLenum capability, bool enabled);
+
+private:
+    GLuint _program{};
+    GLuint _vertexArray{};
+    bool _programKnown{false};
+    bool _vertexArrayKnown{false};
+    GLuint _activeUnit{};
+    bool _activeUnitKnown{false};
+    std::array<TextureBinding, kTextureUnits> _textures;
+    std::array<BufferRange, kUniformBufferBindings> _uniformBuffers;
+    GLenum _blendSource{};
+    GLenum _blendDestination{};
+    bool _blendFuncKnown{false};
+    Flag _blend{Flag::Unknown};
+    Flag _depthTest{Flag::Unknown};
+    Flag _depthWrite{Flag::Unknown};
+    Flag _cullFace{Flag::Unknown};
+    Stats _stats;
+};
+
+} // namespace glesy
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "glesy/Api.h"
+#include "glesy/Buffer.hpp"
+
+#include <deque>
+
+namespace glesy {
+
+/**
+ * Ring buffer for streaming dynamic data (vertices, indices, uniforms) every frame.
+ *
+ * Regions are sub-allocated from one large buffer object and written through
+ * unsynchronized mapping, so the driver never stalls on implicit synchronization.
+ * Regions are guarded by fence sync objects instead: call fence() after issuing the draws
+ * consuming written regions (typically once per frame) and the ring waits for the GPU only
+ * when it wraps around onto a region that might still be in use.
+ *
+ * With Strategy::Orphaning the ring orphans buffer storage on wrap instead of waiting on fences
+ * and write() updates storage with glBufferSubData (for drivers where mapping is slow).
+ */
+class StreamBuffer {
+public:
+    enum class Strategy { Unsynchronized, Orphaning };
+
+    struct Region {
+        void* data{};
+        GLintptr offset{};
+        GLsizeiptr size{};
+    };
+
+    StreamBuffer(GLenum target, GLsizeiptr capacity, Strategy strategy = Strategy::Unsynchronized);
+
+    StreamBuffer(const StreamBuffer&) = delete;
+
+    StreamBuffer&
+    operator=(const StreamBuffer&)
+        = delete;
+
+    ~StreamBuffer();
+
+    [[nodiscard]] const Buffer&
+    buffer() const;
+
+    [[nodiscard]] GLsizeiptr
+    capacity() const;
+
+    [[nodiscard]] Strategy
+    strategy() const;
+
+    /**
+     * Get the number of times the ring had to wait for the GPU
+     */
+    [[nodiscard]] std::size_t
+    stalls() const;
+
+    /**
+     * Allocate and map the region for writing. Region stays mapped until unmap() call.
+     * @param size The size of region in bytes
+     * @param alignment The alignment of region offset (e.g. vertex stride)
+     * @return The mapped region
+     */
+    [[nodiscard]] Region
+    map(GLsizeiptr size, GLsizeiptr alignment = 4);
+
+    /**
+     * Unmap previously mapped region
+     */
+    void
+    unmap();
+
+    /**
+     * Allocate region and copy data into it
+     * @param data The data to copy
+     * @param size The size of data in bytes
+     * @param alignment The alignment of region offset (e.g. vertex stride)
+     * @return The offset of written region inside buffer
+     */
+    GLintptr
+    write(const void* data, GLsizeiptr size, GLsizeiptr alignment = 4);
+
+    /**
+     * Guard all regions written since previous call by fence
+     * @warning Call after draws consuming written regions have been issued
+     */
+    void
+    fence();
+
+private:
+    struct Fence {
+        GLsync sync{};
+        GLintptr begin{};
+        GLsizeiptr size{};
+    };
+
+    GLintptr
+    allocate(GLsizeiptr size, GLsizeiptr alignment);
+
+    void
+    waitFor(GLintptr begin, GLsizeiptr size);
+
+    void
+    orphan();
+
+private:
+    Buffer _buffer;
+    GLsizeiptr _capacity{};
+    Strategy _strategy{};
+    GLintptr _head{};
+    GLintptr _pendingBegin{};
+    GLsizeiptr _pendingSize{};
+    std::deque<Fence> _fences;
+    std::size_t _stalls{};
+    bool _mapped{false};
+};
+
+} // namespace glesy
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <glm/mat4x4.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace glesy {
+
+/**
+ * Scene transform hierarchy. Local and world matrices, parent links and dirty flags are kept in
+ * separate contiguous arrays sorted by hierarchy depth, so every parent precedes its children.
+ * @c update recomputes world matrices of dirty nodes and their subtrees only, level by level,
+ * each level in parallel with SIMD matrix multiplies.
+ *
+ * Nodes are referenced by stable handles, array positions change when hierarchy is modified.
+ */
+class TransformHierarchy {
+public:
+    using Node = std::uint32_t;
+
+    static constexpr Node kInvalidNode{~Node{}};
+
+    /**
+     * Create node
+     * @param parent The parent node, kInvalidNode for root
+     * @param local The transform relative to parent
+     * @return The node handle
+     */
+    Node
+    create(Node parent = kInvalidNode, const glm::mat4& local = glm::mat4{1.0f});
+
+    /**
+     * Destroy node together with its subtree
+     */
+    void
+    destroy(Node node);
+
+    /**
+     * Attach node to the new parent keeping its local transform
+     * @param parent The parent node, kInvalidNode to make node a root
+     * @throw std::invalid_argument if parent belongs to node subtree
+     */
+    void
+    setParent(Node node, Node parent);
+
+    [[nodiscard]] Node
+    parent(Node node) const;
+
+    void
+    setLocal(Node node, const glm::mat4& local);
+
+    [[nodiscard]] const glm::mat4&
+    local(Node node) const;
+
+    /**
+     * Get world transform computed by the last @c update call
+     */
+    [[nodiscard]] const glm::mat4&
+    world(Node node) const;
+
+    [[nodiscard]] bool
+    contains(Node node) const;
+
+    /**
+     * Recompute world matrices of changed subtrees
+     * @param grain The minimum number of nodes updated by one task
+     * @return The number of recomputed world matrices
+     */
+    std::size_t
+    update(std::size_t grain = 1024);
+
+    [[nodiscard]] std::size_t
+    size() const;
+
+    /**
+     * Get world matrices in depth order (valid until hierarchy is modified)
+     */
+    [[nodiscard]] std::span<const glm::mat4>
+    worldMatrices() const;
+
+    /**
+     * Get node handles in depth order, matching @c worldMatrices
+     */
+    [[nodiscard]] std::span<const Node>
+    nodes() const;
+
+private:
+    static constexpr std::uint32_t kNoSlot{~std::uint32_t{}};
+
+    [[nodiscard]] std::uint32_t
+    slot(Node node) const;
+
+    /**
+     * Compute depths of live nodes from parent links, indexed by node handle
+     */
+    [[nodiscard]] std::vector<std::uint32_t>
+    nodeDepths() const;
+
+    void
+    appendSlot(Node node, const glm::mat4& local);
+
+    void
+    rebuild();
+
+private:
+    // Indexed by node handle
+    std::vector<std::uint32_t> _slots;
+    std::vector<Node> _parents;
+    std::vector<Node> _freeNodes;
+
+    // Indexed by slot, sorted by depth
+    std::vector<Node> _nodes;
+    std::vector<std::uint32_t> _parentSlots;
+    std::vector<std::uint32_t> _depths;
+    std::vector<glm::mat4> _locals;
+    std::vector<glm::mat4> _worlds;
+    std::vector<std::uint8_t> _dirty;
+    // Offsets of depth levels, the last one is the slot count
+    std::vector<std::size_t> _levels{0};
+    bool _sorted{true};
+    bool _changed{false};
+};
+
+} // namespace glesy
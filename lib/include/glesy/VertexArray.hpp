@@ -0,0 +1,52 @@
+#pragma once
+
+#include "glesy/Api.h"
+#include "glesy/Buffer.hpp"
+#include "glesy/VertexFormat.hpp"
+
+namespace glesy {
+
+/**
+ * Owns OpenGL vertex array object
+ */
+class VertexArray {
+public:
+    VertexArray();
+
+    VertexArray(VertexArray&& other) noexcept;
+
+    VertexArray&
+    operator=(VertexArray&& other) noexcept;
+
+    ~VertexArray();
+
+    [[nodiscard]] GLuint
+    id() const;
+
+    void
+    bind() const;
+
+    static void
+    unbind();
+
+    /**
+     * Attach vertex buffer and setup attributes according to the format
+     * @param buffer The vertex buffer
+     * @param format The layout of vertex buffer
+     * @param baseOffset The offset of the first vertex in buffer
+     */
+    void
+    setVertexBuffer(const Buffer& buffer, const VertexFormat& format, GLintptr baseOffset = 0);
+
+    /**
+     * Attach index buffer
+     * @param buffer The index buffer
+     */
+    void
+    setIndexBuffer(const Buffer& buffer);
+
+private:
+    GLuint _id{};
+};
+
+} // namespace glesy
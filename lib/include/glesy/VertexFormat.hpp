@@ -0,0 +1,46 @@
+#pragma once
+
+#include "glesy/Api.h"
+
+#include <vector>
+
+namespace glesy {
+
+/**
+ * Describes single vertex attribute inside the vertex buffer
+ */
+struct VertexAttribute {
+    GLuint location{};
+    GLint components{};
+    GLenum type{GL_FLOAT};
+    bool normalized{false};
+    bool integer{false};
+    GLsizei offset{};
+    GLuint divisor{};
+
+    bool
+    operator==(const VertexAttribute&) const
+        = default;
+};
+
+/**
+ * Describes layout of the interleaved vertex buffer
+ */
+struct VertexFormat {
+    GLsizei stride{};
+    std::vector<VertexAttribute> attributes;
+
+    bool
+    operator==(const VertexFormat&) const
+        = default;
+};
+
+/**
+ * Setup and enable vertex attributes of currently bound vertex array object
+ * @param format The vertex format to apply
+ * @param baseOffset The offset of the first vertex in currently bound array buffer
+ */
+void
+applyVertexFormat(const VertexFormat& format, GLintptr baseOffset = 0);
+
+} // namespace glesy
@@ -0,0 +1,191 @@
+#pragma once
+
+#include "glesy/Api.h"
+#include "glesy/VertexFormat.hpp"
+
+#include <array>
+#include <cstddef>
+
+namespace glesy {
+
+namespace detail {
+
+/** Keep every attribute 4-byte aligned as recommended for vertex fetch */
+inline constexpr GLsizei kVertexAttributeAlignment{4};
+
+constexpr bool
+isPackedType(const GLenum type)
+{
+    return type == GL_INT_2_10_10_10_REV or type == GL_UNSIGNED_INT_2_10_10_10_REV;
+}
+
+constexpr bool
+isFloatType(const GLenum type)
+{
+    return type == GL_FLOAT or type == GL_HALF_FLOAT or isPackedType(type);
+}
+
+constexpr GLsizei
+componentSize(const GLenum type)
+{
+    switch (type) {
+    case GL_BYTE:
+    case GL_UNSIGNED_BYTE:
+        return 1;
+    case GL_SHORT:
+    case GL_UNSIGNED_SHORT:
+    case GL_HALF_FLOAT:
+        return 2;
+    case GL_INT:
+    case GL_UNSIGNED_INT:
+    case GL_FLOAT:
+        return 4;
+    default:
+        return 0;
+    }
+}
+
+constexpr GLsizei
+alignUp(const GLsizei value, const GLsizei alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace detail
+
+/**
+ * Compile-time description of the single vertex attribute
+ * @tparam Location The attribute location (must match "layout(location = ...)" in shader)
+ * @tparam Components The number of components (1..4)
+ * @tparam Type The component type (GL_FLOAT, GL_HALF_FLOAT, GL_SHORT, GL_INT_2_10_10_10_REV, ...)
+ * @tparam Normalized Whether fixed-point data is normalized into [0, 1] or [-1, 1]
+ * @tparam Integer Whether data is fed into integer attribute (ivec/uvec)
+ */
+template<GLuint Location,
+         GLint Components,
+         GLenum Type,
+         bool Normalized = false,
+         bool Integer = false>
+struct Attr {
+    static_assert(Components >= 1 and Components <= 4, "Invalid number of components");
+    static_assert(not detail::isPackedType(Type) or Components == 4,
+                  "Packed 2_10_10_10 formats require 4 components");
+    static_assert(detail::isPackedType(Type) or detail::componentSize(Type) > 0,
+                  "Unsupported component type");
+    static_assert(not Integer or not(Normalized or detail::isFloatType(Type)),
+                  "Integer attribute requires non-normalized integer type");
+
+    static constexpr GLuint kLocation{Location};
+    static constexpr GLsizei kSize{detail::isPackedType(Type)
+                                       ? 4
+                                       : Components * detail::componentSize(Type)};
+
+    static constexpr VertexAttribute
+    attribute(const GLsizei offset, const GLuint divisor = 0)
+    {
+        return {Location, Components, Type, Normalized, Integer, offset, divisor};
+    }
+};
+
+template<GLuint Location, GLint Components>
+using FloatAttr = Attr<Location, Components, GL_FLOAT>;
+
+template<GLuint Location, GLint Components>
+using HalfAttr = Attr<Location, Components, GL_HALF_FLOAT>;
+
+template<GLuint Location, GLint Components>
+using SNorm16Attr = Attr<Location, Components, GL_SHORT, true>;
+
+template<GLuint Location, GLint Components>
+using UNorm16Attr = Attr<Location, Components, GL_UNSIGNED_SHORT, true>;
+
+template<GLuint Location, GLint Components>
+using UNorm8Attr = Attr<Location, Components, GL_UNSIGNED_BYTE, true>;
+
+template<GLuint Location>
+using SNorm1010102Attr = Attr<Location, 4, GL_INT_2_10_10_10_REV, true>;
+
+template<GLuint Location, GLint Components>
+using IntAttr = Attr<Location, Components, GL_INT, false, true>;
+
+template<GLuint Location, GLint Components>
+using UIntAttr = Attr<Location, Components, GL_UNSIGNED_INT, false, true>;
+
+/**
+ * Interleaved vertex layout with offsets and stride computed at compile time.
+ *
+ * Usage:
+ * @code
+ * struct Vertex {
+ *     float position[3];
+ *     std::uint32_t normal; // packSnorm1010102()
+ *     std::uint16_t texCoord[2]; // packHalf()
+ * };
+ * using Layout = VertexLayout<FloatAttr<0, 3>, SNorm1010102Attr<1>, HalfAttr<2, 2>>;
+ * static_assert(sizeof(Vertex) == Layout::kStride);
+ * @endcode
+ */
+template<typename... Attrs>
+struct VertexLayout {
+    static constexpr std::size_t kCount{sizeof...(Attrs)};
+
+    static constexpr std::array<GLsizei, kCount> kOffsets = [] {
+        std::array<GLsizei, kCount> offsets{};
+        GLsizei offset{};
+        std::size_t index{};
+        ((offsets[index++] = offset,
+          offset = detail::alignUp(offset + Attrs::kSize, detail::kVertexAttributeAlignment)),
+         ...);
+        return offsets;
+    }();
+
+    static constexpr GLsizei kStride{
+        (detail::alignUp(Attrs::kSize, detail::kVertexAttributeAlignment) + ... + 0)};
+
+    static constexpr std::array<VertexAttribute, kCount> kAttributes = [] {
+        std::size_t index{};
+        return std::array<VertexAttribute, kCount>{Attrs::attribute(kOffsets[index++])...};
+    }();
+
+    static_assert(kCount > 0, "Vertex layout requires at least one attribute");
+    static_assert(
+        [] {
+            for (std::size_t i = 0; i < kCount; ++i) {
+                for (std::size_t j = i + 1; j < kCount; ++j) {
+                    if (kAttributes[i].location == kAttributes[j].location) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }(),
+        "Duplicated attribute location");
+
+    /**
+     * Get runtime vertex format (built once on the first call)
+     */
+    static const VertexFormat&
+    format()
+    {
+        static const VertexFormat kFormat{kStride, {kAttributes.begin(), kAttributes.end()}};
+        return kFormat;
+    }
+
+    /**
+     * Get runtime vertex format with attributes advanced once per instance
+     */
+    static const VertexFormat&
+    instanceFormat()
+    {
+        static const VertexFormat kFormat = [] {
+            VertexFormat format{kStride, {kAttributes.begin(), kAttributes.end()}};
+            for (auto& attr : format.attributes) {
+                attr.divisor = 1;
+            }
+            return format;
+        }();
+        return kFormat;
+    }
+};
+
+} // namespace glesy
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "glesy/Api.h"
+
+#include <GLFW/glfw3.h>
+
+#include <atomic>
+#include <string>
+#include <utility>
+
+namespace glesy {
+
+struct WindowSettings {
+    std::string title{"glesy"};
+    int width{800};
+    int height{600};
+    /** The number of screen updates to wait before swapping buffers (0 disables vsync) */
+    int swapInterval{1};
+};
+
+/**
+ * GLFW window with OpenGL 3.3 core context. Owns GLFW library initialization, so only one
+ * window may exist at a time. Must be created and destroyed on the main thread.
+ */
+class Window {
+public:
+    /**
+     * Create window, make its context current and load OpenGL functions
+     * @throw std::runtime_error if window or context creation fails
+     */
+    explicit Window(const WindowSettings& settings);
+
+    Window(const Window&) = delete;
+
+    Window&
+    operator=(const Window&)
+        = delete;
+
+    ~Window();
+
+    [[nodiscard]] GLFWwindow*
+    handle() const;
+
+    [[nodiscard]] const WindowSettings&
+    settings() const;
+
+    /**
+     * Check close flag (any thread)
+     */
+    [[nodiscard]] bool
+    shouldClose() const;
+
+    /**
+     * Request window close (any thread)
+     */
+    void
+    close();
+
+    /**
+     * Make window context current on calling thread
+     */
+    void
+    makeCurrent();
+
+    /**
+     * Detach any context from calling thread
+     */
+    static void
+    releaseCurrent();
+
+    /**
+     * Swap front and back buffers (thread owning the context)
+     */
+    void
+    swapBuffers();
+
+    /**
+     * Get framebuffer size in pixels, updated by resize events (any thread)
+     */
+    [[nodiscard]] std::pair<int, int>
+    framebufferSize() const;
+
+    /**
+     * Get refresh rate of the primary monitor (main thread)
+     * @return The refresh rate in Hz, 60 if it is unknown
+     */
+    [[nodiscard]] static double
+    refreshRate();
+
+private:
+    static void
+    onFramebufferResize(GLFWwindow* window, int width, int height);
+
+private:
+    WindowSettings _settings;
+    GLFWwindow* _handle{};
+    std::atomic<int> _width{};
+    std::atomic<int> _height{};
+};
+
+} // namespace glesy
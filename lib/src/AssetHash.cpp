@@ -0,0 +1,65 @@
+#include "glesy/AssetHash.hpp"
+
+#include "glesy/MappedFile.hpp"
+
+#include <cstring>
+#include <system_error>
+
+namespace glesy {
+
+namespace {
+
+constexpr std::uint64_t kFnvPrime{0x100000001b3ULL};
+constexpr std::uint64_t kWordMultiplier{0x9e3779b97f4a7c15ULL};
+
+} // namespace
+
+std::uint64_t
+hashBytes(const std::span<const std::byte> bytes, std::uint64_t seed)
+{
+    const std::size_t words = bytes.size() / sizeof(std::uint64_t);
+    for (std::size_t index = 0; index < words; ++index) {
+        std::uint64_t word{};
+        std::memcpy(&word, bytes.data() + index * sizeof(std::uint64_t), sizeof(word));
+        seed = (seed ^ word) * kWordMultiplier;
+        seed ^= seed >> 32;
+    }
+    for (const std::byte byte : bytes.subspan(words * sizeof(std::uint64_t))) {
+        seed ^= static_cast<std::uint64_t>(byte);
+        seed *= kFnvPrime;
+    }
+    return seed;
+}
+
+FileStamp
+FileStamp::of(const std::filesystem::path& path)
+{
+    return FileStamp{.path = path,
+                     .size = std::filesystem::file_size(path),
+                     .modified = std::filesystem::last_write_time(path).time_since_epoch().count()};
+}
+
+bool
+FileStamp::current() const
+{
+    std::error_code error;
+    const auto currentSize = std::filesystem::file_size(path, error);
+    if (error or currentSize != size) {
+        return false;
+    }
+    const auto currentTime = std::filesystem::last_write_time(path, error);
+    return not error and currentTime.time_since_epoch().count() == modified;
+}
+
+std::uint64_t
+assetHash(const std::span<const std::filesystem::path> files, const std::uint64_t cookerHash)
+{
+    std::uint64_t hash = hashValue(cookerHash);
+    for (const auto& path : files) {
+        const MappedFile file{path};
+        hash = hashBytes(file.bytes(), hashValue(file.size(), hash));
+    }
+    return hash;
+}
+
+} // namespace glesy
@@ -0,0 +1,123 @@
+#include "glesy/Buffer.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <utility>
+
+namespace glesy {
+
+namespace {
+
+std::uint64_t
+nextSerial()
+{
+    static std::atomic<std::uint64_t> serial{};
+    return serial.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+} // namespace
+
+Buffer::Buffer(const GLenum target)
+    : _serial{nextSerial()}
+    , _target{target}
+{
+    if (glGenBuffers(1, &_id); _id == 0) {
+        throw std::runtime_error("Failed to create buffer");
+    }
+}
+
+Buffer::Buffer(const GLenum target, const GLsizeiptr size, const void* data, const GLenum usage)
+    : Buffer{target}
+{
+    setData(size, data, usage);
+}
+
+Buffer::Buffer(Buffer&& other) noexcept
+    : _id{std::exchange(other._id, 0)}
+    , _serial{std::exchange(other._serial, 0)}
+    , _target{other._target}
+    , _size{std::exchange(other._size, 0)}
+{
+}
+
+Buffer&
+Buffer::operator=(Buffer&& other) noexcept
+{
+    if (this != &other) {
+        glDeleteBuffers(1, &_id);
+        _id = std::exchange(other._id, 0);
+        _serial = std::exchange(other._serial, 0);
+        _target = other._target;
+        _size = std::exchange(other._size, 0);
+    }
+    return *this;
+}
+
+Buffer::~Buffer()
+{
+    glDeleteBuffers(1, &_id);
+}
+
+GLuint
+Buffer::id() const
+{
+    return _id;
+}
+
+std::uint64_t
+Buffer::serial() const
+{
+    return _serial;
+}
+
+GLenum
+Buffer::target() const
+{
+    return _target;
+}
+
+GLsizeiptr
+Buffer::size() const
+{
+    return _size;
+}
+
+void
+Buffer::bind() const
+{
+    glBindBuffer(_target, _id);
+}
+
+void
+Buffer::setData(const GLsizeiptr size, const void* data, const GLenum usage)
+{
+    // Upload through the copy target, binding GL_ELEMENT_ARRAY_BUFFER would replace index
+    // buffer of the bound vertex array
+    glBindBuffer(GL_COPY_WRITE_BUFFER, _id);
+    glBufferData(GL_COPY_WRITE_BUFFER, size, data, usage);
+    _size = size;
+}
+
+void
+Buffer::setSubData(const GLintptr offset, const GLsizeiptr size, const void* data)
+{
+    glBindBuffer(GL_COPY_WRITE_BUFFER, _id);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, offset, size, data);
+}
+
+void
+Buffer::copySubData(const Buffer& source,
+                    const GLintptr readOffset,
+                    const GLintptr writeOffset,
+                    const GLsizeiptr size)
+{
+    if (size <= 0) {
+        return;
+    }
+    // Copy targets don't affect any other binding (e.g. index buffer of bound vertex array)
+    glBindBuffer(GL_COPY_READ_BUFFER, source._id);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, _id);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, readOffset, writeOffset, size);
+}
+
+} // namespace glesy
@@ -0,0 +1,74 @@
+#include "glesy/CommandBuffer.hpp"
+
+#include <algorithm>
+
+namespace glesy {
+
+void
+CommandBuffer::push(const RenderCommand& command)
+{
+    _commands.push_back(command);
+}
+
+void
+CommandBuffer::reserve(const std::size_t count)
+{
+    _commands.reserve(count);
+}
+
+void
+CommandBuffer::clear()
+{
+    _commands.clear();
+}
+
+std::span<const RenderCommand>
+CommandBuffer::commands() const
+{
+    return _commands;
+}
+
+std::size_t
+CommandBuffer::size() const
+{
+    return _commands.size();
+}
+
+bool
+CommandBuffer::empty() const
+{
+    return _commands.empty();
+}
+
+CommandRecorder::CommandRecorder(const std::size_t buffers)
+    : _buffers(std::max<std::size_t>(buffers, 1))
+{
+}
+
+CommandBuffer&
+CommandRecorder::buffer(const std::size_t index)
+{
+    return _buffers.at(index);
+}
+
+std::size_t
+CommandRecorder::bufferCount() const
+{
+    return _buffers.size();
+}
+
+void
+CommandRecorder::submit(RenderQueue& queue)
+{
+    std::size_t total{};
+    for (const auto& buffer : _buffers) {
+        total += buffer.size();
+    }
+    queue.reserve(queue.size() + total);
+    for (auto& buffer : _buffers) {
+        queue.append(buffer.commands());
+        buffer.clear();
+    }
+}
+
+} // namespace glesy
@@ -0,0 +1,440 @@
+#include "glesy/DepthRasterizer.hpp"
+#include "glesy/Parallel.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) and defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace glesy {
+
+namespace {
+
+constexpr float kFarDepth{1.0f};
+constexpr int kTileLevels{5}; // log2(kTileSize)
+static_assert((1 << kTileLevels) == DepthRasterizer::kTileSize);
+
+int
+roundUpToTile(const int size)
+{
+    return std::max(1, (size + DepthRasterizer::kTileSize - 1) / DepthRasterizer::kTileSize)
+           * DepthRasterizer::kTileSize;
+}
+
+bool
+outside(const glm::vec4& v0, const glm::vec4& v1, const glm::vec4& v2, const int axis)
+{
+    return (v0[axis] > v0.w and v1[axis] > v1.w and v2[axis] > v2.w)
+           or (v0[axis] < -v0.w and v1[axis] < -v1.w and v2[axis] < -v2.w);
+}
+
+/**
+ * Rasterize four adjacent pixels of the row, keeping the nearest depth
+ */
+void
+rasterizeQuad(const float* edgeA,
+              const float* rowEdge,
+              const float depthX,
+              const float rowDepth,
+              const int x,
+              float* output)
+{
+#if defined(__SSE2__)
+    const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)),
+                                 _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f));
+    const __m128 zero = _mm_setzero_ps();
+    __m128 inside = _mm_cmpge_ps(
+        _mm_add_ps(_mm_mul_ps(_mm_set1_ps(edgeA[0]), px), _mm_set1_ps(rowEdge[0])), zero);
+    inside = _mm_and_ps(
+        inside,
+        _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(edgeA[1]), px), _mm_set1_ps(rowEdge[1])),
+                     zero));
+    inside = _mm_and_ps(
+        inside,
+        _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(edgeA[2]), px), _mm_set1_ps(rowEdge[2])),
+                     zero));
+    if (_mm_movemask_ps(inside) == 0) {
+        return;
+    }
+    const __m128 depth = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(depthX), px), _mm_set1_ps(rowDepth));
+    const __m128 masked = _mm_or_ps(_mm_and_ps(inside, depth),
+                                    _mm_andnot_ps(inside, _mm_set1_ps(kFarDepth)));
+    _mm_storeu_ps(output, _mm_min_ps(_mm_loadu_ps(output), masked));
+#elif defined(__ARM_NEON) and defined(__aarch64__)
+    static constexpr float kOffsets[4]{0.5f, 1.5f, 2.5f, 3.5f};
+    const float32x4_t px = vaddq_f32(vdupq_n_f32(static_cast<float>(x)), vld1q_f32(kOffsets));
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    uint32x4_t inside = vcgeq_f32(vfmaq_n_f32(vdupq_n_f32(rowEdge[0]), px, edgeA[0]), zero);
+    inside = vandq_u32(inside, vcgeq_f32(vfmaq_n_f32(vdupq_n_f32(rowEdge[1]), px, edgeA[1]), zero));
+    inside = vandq_u32(inside, vcgeq_f32(vfmaq_n_f32(vdupq_n_f32(rowEdge[2]), px, edgeA[2]), zero));
+    if (vmaxvq_u32(inside) == 0) {
+        return;
+    }
+    const float32x4_t depth = vfmaq_n_f32(vdupq_n_f32(rowDepth), px, depthX);
+    const float32x4_t masked = vbslq_f32(inside, depth, vdupq_n_f32(kFarDepth));
+    vst1q_f32(output, vminq_f32(vld1q_f32(output), masked));
+#else
+    for (int lane = 0; lane < 4; ++lane) {
+        const float px = static_cast<float>(x + lane) + 0.5f;
+        if (edgeA[0] * px + rowEdge[0] >= 0.0f and edgeA[1] * px + rowEdge[1] >= 0.0f
+            and edgeA[2] * px + rowEdge[2] >= 0.0f) {
+            output[lane] = std::min(output[lane], depthX * px + rowDepth);
+        }
+    }
+#endif
+}
+
+} // namespace
+
+DepthRasterizer::DepthRasterizer(const int width, const int height)
+    : _width{roundUpToTile(width)}
+    , _height{roundUpToTile(height)}
+    , _tilesX{_width / kTileSize}
+    , _tilesY{_height / kTileSize}
+    , _bins(static_cast<std::size_t>(_tilesX * _tilesY))
+{
+    int levelWidth = _width;
+    int levelHeight = _height;
+    while (true) {
+        const auto texels = static_cast<std::size_t>(levelWidth * levelHeight);
+        _levels.push_back(Level{.width = levelWidth,
+                                .height = levelHeight,
+                                .depth = std::vector<float>(texels, kFarDepth)});
+        if (levelWidth == 1 and levelHeight == 1) {
+            break;
+        }
+        levelWidth = (levelWidth + 1) / 2;
+        levelHeight = (levelHeight + 1) / 2;
+    }
+}
+
+int
+DepthRasterizer::width() const
+{
+    return _width;
+}
+
+int
+DepthRasterizer::height() const
+{
+    return _height;
+}
+
+void
+DepthRasterizer::clear()
+{
+    for (auto& level : _levels) {
+        std::ranges::fill(level.depth, kFarDepth);
+    }
+    _triangles.clear();
+    for (auto& bin : _bins) {
+        bin.clear();
+    }
+    _stats = Stats{};
+}
+
+void
+DepthRasterizer::addOccluder(const std::span<const glm::vec3> vertices,
+                             const std::span<const std::uint32_t> indices,
+                             const glm::mat4& modelViewProjection)
+{
+    std::vector<glm::vec4> clip(vertices.size());
+    for (std::size_t index = 0; index < vertices.size(); ++index) {
+        clip[index] = modelViewProjection * glm::vec4{vertices[index], 1.0f};
+    }
+    for (std::size_t index = 0; index + 2 < indices.size(); index += 3) {
+        addTriangle(clip[indices[index]], clip[indices[index + 1]], clip[indices[index + 2]]);
+    }
+    _stats.occluders++;
+}
+
+void
+DepthRasterizer::rasterize()
+{
+    parallelFor(_bins.size(), 1, [this](const std::size_t begin, const std::size_t end) {
+        for (std::size_t tile = begin; tile < end; ++tile) {
+            rasterizeTile(static_cast<int>(tile));
+            reduceTile(static_cast<int>(tile));
+        }
+    });
+    // Levels coarser than a tile are small
+    for (std::size_t level = kTileLevels + 1; level < _levels.size(); ++level) {
+        reduceLevel(level);
+    }
+}
+
+bool
+DepthRasterizer::isVisible(const glm::vec3& minimum,
+                           const glm::vec3& maximum,
+                           const glm::mat4& viewProjection) const
+{
+    // Corners are the transformed minimum plus combinations of transformed box edges, kept in
+    // component arrays so the loops below vectorize
+    const glm::vec3 extent = maximum - minimum;
+    float corners[4][8];
+    for (int component = 0; component < 4; ++component) {
+        const float origin = viewProjection[0][component] * minimum.x
+                             + viewProjection[1][component] * minimum.y
+                             + viewProjection[2][component] * minimum.z
+                             + viewProjection[3][component];
+        const float edgeX = viewProjection[0][component] * extent.x;
+        const float edgeY = viewProjection[1][component] * extent.y;
+        const float edgeZ = viewProjection[2][component] * extent.z;
+        for (int corner = 0; corner < 8; ++corner) {
+            corners[component][corner] = origin + (((corner & 1) != 0) ? edgeX : 0.0f)
+                                          + (((corner & 2) != 0) ? edgeY : 0.0f)
+                                          + (((corner & 4) != 0) ? edgeZ : 0.0f);
+        }
+    }
+
+    int behind{};
+    glm::vec3 ndcMin{std::numeric_limits<float>::max()};
+    glm::vec3 ndcMax{std::numeric_limits<float>::lowest()};
+    for (int corner = 0; corner < 8; ++corner) {
+        const float w = corners[3][corner];
+        behind += (corners[2][corner] < -w or w <= 0.0f) ? 1 : 0;
+        const float inverseW = 1.0f / w;
+        const float x = corners[0][corner] * inverseW;
+        const float y = corners[1][corner] * inverseW;
+        const float z = corners[2][corner] * inverseW;
+        ndcMin.x = std::min(ndcMin.x, x);
+        ndcMin.y = std::min(ndcMin.y, y);
+        ndcMin.z = std::min(ndcMin.z, z);
+        ndcMax.x = std::max(ndcMax.x, x);
+        ndcMax.y = std::max(ndcMax.y, y);
+    }
+    if (behind > 0) {
+        // Box entirely behind the near plane is outside the frustum, crossing one is not tested
+        return behind < 8;
+    }
+    if (ndcMax.x < -1.0f or ndcMin.x > 1.0f or ndcMax.y < -1.0f or ndcMin.y > 1.0f
+        or ndcMin.z > 1.0f) {
+        return false;
+    }
+
+    const auto toPixel = [](const float ndc, const int size) {
+        const float pixel = std::floor((ndc * 0.5f + 0.5f) * static_cast<float>(size));
+        return std::clamp(static_cast<int>(pixel), 0, size - 1);
+    };
+    const int x0 = toPixel(ndcMin.x, _width);
+    const int x1 = toPixel(ndcMax.x, _width);
+    const int y0 = toPixel(ndcMin.y, _height);
+    const int y1 = toPixel(ndcMax.y, _height);
+    const float nearest = ndcMin.z * 0.5f + 0.5f;
+
+    // Pick level where the rectangle covers at most 3x3 texels
+    const int size = std::max(x1 - x0, y1 - y0) + 1;
+    std::size_t level{};
+    while ((size >> level) > 2 and level + 1 < _levels.size()) {
+        level++;
+    }
+    const auto& hiz = _levels[level];
+    for (int y = y0 >> level; y <= (y1 >> level); ++y) {
+        for (int x = x0 >> level; x <= (x1 >> level); ++x) {
+            if (nearest <= hiz.depth[static_cast<std::size_t>(y * hiz.width + x)]) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+std::size_t
+DepthRasterizer::filterVisible(const std::span<const glm::vec3> minimums,
+                               const std::span<const glm::vec3> maximums,
+                               const glm::mat4& viewProjection,
+                               std::vector<std::uint32_t>& indices)
+{
+    std::vector<std::uint8_t> visible(indices.size());
+    parallelFor(indices.size(), 256, [&](const std::size_t begin, const std::size_t end) {
+        for (std::size_t index = begin; index < end; ++index) {
+            const auto object = indices[index];
+            visible[index] = isVisible(minimums[object], maximums[object], viewProjection) ? 1 : 0;
+        }
+    });
+
+    std::size_t count{};
+    for (std::size_t index = 0; index < indices.size(); ++index) {
+        if (visible[index] != 0) {
+            indices[count++] = indices[index];
+        }
+    }
+    _stats.tested += indices.size();
+    _stats.occluded += indices.size() - count;
+    indices.resize(count);
+    return count;
+}
+
+std::span<const float>
+DepthRasterizer::depth() const
+{
+    return _levels.front().depth;
+}
+
+const DepthRasterizer::Stats&
+DepthRasterizer::stats() const
+{
+    return _stats;
+}
+
+void
+DepthRasterizer::addTriangle(const glm::vec4& v0, const glm::vec4& v1, const glm::vec4& v2)
+{
+    _stats.triangles++;
+    if (outside(v0, v1, v2, 0) or outside(v0, v1, v2, 1)
+        or (v0.z > v0.w and v1.z > v1.w and v2.z > v2.w)) {
+        return;
+    }
+
+    // Clip against the near plane (z >= -w)
+    const std::array<glm::vec4, 3> input{v0, v1, v2};
+    std::array<glm::vec4, 4> polygon;
+    std::size_t count{};
+    for (std::size_t index = 0; index < 3; ++index) {
+        const auto& current = input[index];
+        const auto& next = input[(index + 1) % 3];
+        const float currentDistance = current.z + current.w;
+        const float nextDistance = next.z + next.w;
+        if (currentDistance >= 0.0f) {
+            polygon[count++] = current;
+        }
+        if ((currentDistance >= 0.0f) != (nextDistance >= 0.0f)) {
+            const float t = currentDistance / (currentDistance - nextDistance);
+            polygon[count++] = current + (next - current) * t;
+        }
+    }
+    for (std::size_t index = 2; index < count; ++index) {
+        addClippedTriangle(polygon[0], polygon[index - 1], polygon[index]);
+    }
+}
+
+void
+DepthRasterizer::addClippedTriangle(const glm::vec4& v0, const glm::vec4& v1, const glm::vec4& v2)
+{
+    const auto toScreen = [this](const glm::vec4& clip) {
+        const glm::vec3 ndc = glm::vec3{clip} / clip.w;
+        return glm::vec3{(ndc.x * 0.5f + 0.5f) * static_cast<float>(_width),
+                         (ndc.y * 0.5f + 0.5f) * static_cast<float>(_height),
+                         ndc.z * 0.5f + 0.5f};
+    };
+    const std::array<glm::vec3, 3> screen{toScreen(v0), toScreen(v1), toScreen(v2)};
+
+    const float area = (screen[1].x - screen[0].x) * (screen[2].y - screen[0].y)
+                       - (screen[2].x - screen[0].x) * (screen[1].y - screen[0].y);
+    if (not(area > 0.0f)) {
+        // Back facing or degenerate
+        return;
+    }
+
+    Triangle triangle;
+    const float minX = std::min({screen[0].x, screen[1].x, screen[2].x});
+    const float maxX = std::max({screen[0].x, screen[1].x, screen[2].x});
+    const float minY = std::min({screen[0].y, screen[1].y, screen[2].y});
+    const float maxY = std::max({screen[0].y, screen[1].y, screen[2].y});
+    triangle.minX = std::max(0, static_cast<int>(std::floor(minX)));
+    triangle.minY = std::max(0, static_cast<int>(std::floor(minY)));
+    triangle.maxX = std::min(_width - 1, static_cast<int>(std::floor(maxX)));
+    triangle.maxY = std::min(_height - 1, static_cast<int>(std::floor(maxY)));
+    if (triangle.minX > triangle.maxX or triangle.minY > triangle.maxY) {
+        return;
+    }
+
+    // Edge opposite to vertex i is positive inside and equals its barycentric weight times area
+    triangle.depth0 = 0.0f;
+    triangle.depthX = 0.0f;
+    triangle.depthY = 0.0f;
+    for (std::size_t edge = 0; edge < 3; ++edge) {
+        const auto& from = screen[(edge + 1) % 3];
+        const auto& to = screen[(edge + 2) % 3];
+        triangle.edgeA[edge] = from.y - to.y;
+        triangle.edgeB[edge] = to.x - from.x;
+        triangle.edgeC[edge] = -(triangle.edgeA[edge] * from.x + triangle.edgeB[edge] * from.y);
+        triangle.depthX += triangle.edgeA[edge] * screen[edge].z / area;
+        triangle.depthY += triangle.edgeB[edge] * screen[edge].z / area;
+        triangle.depth0 += triangle.edgeC[edge] * screen[edge].z / area;
+    }
+
+    const auto index = static_cast<std::uint32_t>(_triangles.size());
+    _triangles.push_back(triangle);
+    for (int tileY = triangle.minY / kTileSize; tileY <= triangle.maxY / kTileSize; ++tileY) {
+        for (int tileX = triangle.minX / kTileSize; tileX <= triangle.maxX / kTileSize; ++tileX) {
+            _bins[static_cast<std::size_t>(tileY * _tilesX + tileX)].push_back(index);
+            _stats.binned++;
+        }
+    }
+}
+
+void
+DepthRasterizer::rasterizeTile(const int tile)
+{
+    const int tileX = (tile % _tilesX) * kTileSize;
+    const int tileY = (tile / _tilesX) * kTileSize;
+    auto& depth = _levels.front().depth;
+
+    for (const auto index : _bins[static_cast<std::size_t>(tile)]) {
+        const auto& triangle = _triangles[index];
+        // Quads start at multiples of four inside the tile
+        const int x0 = std::max(triangle.minX, tileX) & ~3;
+        const int x1 = std::min(triangle.maxX, tileX + kTileSize - 1);
+        const int y0 = std::max(triangle.minY, tileY);
+        const int y1 = std::min(triangle.maxY, tileY + kTileSize - 1);
+        for (int y = y0; y <= y1; ++y) {
+            const float py = static_cast<float>(y) + 0.5f;
+            const float rowEdge[3]{triangle.edgeB[0] * py + triangle.edgeC[0],
+                                   triangle.edgeB[1] * py + triangle.edgeC[1],
+                                   triangle.edgeB[2] * py + triangle.edgeC[2]};
+            const float rowDepth = triangle.depthY * py + triangle.depth0;
+            float* row = depth.data() + static_cast<std::ptrdiff_t>(y) * _width;
+            for (int x = x0; x <= x1; x += 4) {
+                rasterizeQuad(triangle.edgeA, rowEdge, triangle.depthX, rowDepth, x, row + x);
+            }
+        }
+    }
+}
+
+void
+DepthRasterizer::reduceTile(const int tile)
+{
+    for (std::size_t level = 1; level <= kTileLevels; ++level) {
+        const auto& source = _levels[level - 1];
+        auto& target = _levels[level];
+        const int size = kTileSize >> level;
+        const int originX = (tile % _tilesX) * size;
+        const int originY = (tile / _tilesX) * size;
+        for (int y = originY; y < originY + size; ++y) {
+            for (int x = originX; x < originX + size; ++x) {
+                const auto* top = source.depth.data() + (2 * y + 1) * source.width + 2 * x;
+                const auto* bottom = source.depth.data() + (2 * y) * source.width + 2 * x;
+                target.depth[static_cast<std::size_t>(y * target.width + x)]
+                    = std::max({bottom[0], bottom[1], top[0], top[1]});
+            }
+        }
+    }
+}
+
+void
+DepthRasterizer::reduceLevel(const std::size_t level)
+{
+    const auto& source = _levels[level - 1];
+    auto& target = _levels[level];
+    for (int y = 0; y < target.height; ++y) {
+        for (int x = 0; x < target.width; ++x) {
+            float value{};
+            for (int sy = 2 * y; sy < std::min(2 * y + 2, source.height); ++sy) {
+                for (int sx = 2 * x; sx < std::min(2 * x + 2, source.width); ++sx) {
+                    const auto texel = static_cast<std::size_t>(sy * source.width + sx);
+                    value = std::max(value, source.depth[texel]);
+                }
+            }
+            target.depth[static_cast<std::size_t>(y * target.width + x)] = value;
+        }
+    }
+}
+
+} // namespace glesy
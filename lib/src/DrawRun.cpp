@@ -0,0 +1,140 @@
+#include "glesy/DrawRun.hpp"
+
+#include "glesy/Indices.hpp"
+
+#include <stdexcept>
+
+namespace glesy {
+
+namespace {
+
+bool
+isListPrimitive(const GLenum primitive)
+{
+    return primitive == GL_TRIANGLES or primitive == GL_LINES or primitive == GL_POINTS;
+}
+
+} // namespace
+
+float
+DrawRun::Stats::drawsPerCall() const
+{
+    return (calls > 0) ? static_cast<float>(draws) / static_cast<float>(calls) : 0.0f;
+}
+
+DrawRun::DrawRun(const GLenum indexType, const GLenum primitive)
+    : _indexType{indexType}
+    , _primitive{primitive}
+    , _indexSize{indexTypeSize(indexType)}
+{
+}
+
+void
+DrawRun::add(const GLsizei count, const GLintptr indexOffset, const GLint baseVertex)
+{
+    if (count <= 0) {
+        return;
+    }
+    _stats.draws++;
+
+    if (not _counts.empty() and _baseVertices.back() == baseVertex) {
+        const auto lastEnd = reinterpret_cast<GLintptr>(_offsets.back())
+                             + static_cast<GLintptr>(_counts.back() * _indexSize);
+        // Strips, loops and fans can't be merged without restart index in between
+        if (lastEnd == indexOffset and isListPrimitive(_primitive)) {
+            _counts.back() += count;
+            return;
+        }
+    }
+    _counts.push_back(count);
+    _offsets.push_back(reinterpret_cast<const void*>(indexOffset));
+    _baseVertices.push_back(baseVertex);
+}
+
+void
+DrawRun::add(const GeometryHeap& heap, const GeometryHeap::Handle handle)
+{
+    const auto& range = heap.range(handle);
+    add(heap, handle, MeshLod{.indexCount = static_cast<GLuint>(range.indexCount)});
+}
+
+void
+DrawRun::add(const GeometryHeap& heap, const GeometryHeap::Handle handle, const MeshLod& lod)
+{
+    add(heap, handle, lod.firstIndex, static_cast<GLsizei>(lod.indexCount));
+}
+
+void
+DrawRun::add(const GeometryHeap& heap,
+             const GeometryHeap::Handle handle,
+             const GLuint firstIndex,
+             const GLsizei count)
+{
+    if (heap.indexType() != _indexType) {
+        throw std::invalid_argument{"Index type of geometry heap doesn't match draw run one"};
+    }
+    const auto offset = heap.indexOffset(handle) + static_cast<GLintptr>(firstIndex * _indexSize);
+    add(count, offset, heap.range(handle).baseVertex);
+}
+
+void
+DrawRun::flush()
+{
+    if (_counts.empty()) {
+        return;
+    }
+    glMultiDrawElementsBaseVertex(_primitive,
+                                  _counts.data(),
+                                  _indexType,
+                                  _offsets.data(),
+                                  static_cast<GLsizei>(_counts.size()),
+                                  _baseVertices.data());
+    _stats.calls++;
+    clear();
+}
+
+void
+DrawRun::clear()
+{
+    _counts.clear();
+    _offsets.clear();
+    _baseVertices.clear();
+}
+
+bool
+DrawRun::empty() const
+{
+    return _counts.empty();
+}
+
+std::size_t
+DrawRun::size() const
+{
+    return _counts.size();
+}
+
+GLenum
+DrawRun::indexType() const
+{
+    return _indexType;
+}
+
+GLenum
+DrawRun::primitive() const
+{
+    return _primitive;
+}
+
+const DrawRun::Stats&
+DrawRun::stats() const
+{
+    return _stats;
+}
+
+void
+DrawRun::resetStats()
+{
+    _stats = {};
+}
+
+} // namespace glesy
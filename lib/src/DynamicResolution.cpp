@@ -0,0 +1,165 @@
+#include "glesy/DynamicResolution.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace glesy {
+
+namespace {
+
+// Weight of the new measurement in the exponential moving average
+constexpr double kSmoothing{0.2};
+
+GLsizei
+scaled(const GLsizei size, const float scale)
+{
+    const auto scaledSize = static_cast<GLsizei>(std::lround(static_cast<float>(size) * scale));
+    return std::max<GLsizei>(1, scaledSize);
+}
+
+} // namespace
+
+DynamicResolution::DynamicResolution(const DynamicResolutionSettings& settings,
+                                     const GLsizei outputWidth,
+                                     const GLsizei outputHeight)
+    : _settings{settings}
+    , _scale{settings.maxScale}
+{
+    if (not(_settings.minScale > 0.0f and _settings.minScale <= _settings.maxScale)
+        or _settings.budget <= 0.0 or _settings.lowerThreshold >= _settings.upperThreshold) {
+        throw std::invalid_argument{"Invalid dynamic resolution settings"};
+    }
+    resize(outputWidth, outputHeight);
+}
+
+void
+DynamicResolution::resize(const GLsizei outputWidth, const GLsizei outputHeight)
+{
+    _outputWidth = std::max<GLsizei>(outputWidth, 1);
+    _outputHeight = std::max<GLsizei>(outputHeight, 1);
+
+    const GLsizei width = scaled(_outputWidth, _settings.maxScale);
+    const GLsizei height = scaled(_outputHeight, _settings.maxScale);
+    _color.emplace(RenderTargetDesc{width, height, _settings.colorFormat});
+    _depth.emplace(RenderTargetDesc{width, height, _settings.depthFormat});
+    _framebuffer = Framebuffer{};
+    _framebuffer.attach(0, *_color);
+    _framebuffer.attach(0, *_depth);
+    _framebuffer.setDrawBuffers(1);
+    if (not _framebuffer.complete()) {
+        throw std::runtime_error{"Failed to create dynamic resolution framebuffer"};
+    }
+    Framebuffer::unbind();
+}
+
+void
+DynamicResolution::begin()
+{
+    _framebuffer.bind();
+    glViewport(0, 0, width(), height());
+    _timer.begin();
+}
+
+void
+DynamicResolution::end()
+{
+    _timer.end();
+    if (_timer.samples() != _samples) {
+        _samples = _timer.samples();
+        update(_timer.milliseconds());
+    }
+}
+
+void
+DynamicResolution::present(const GLuint framebuffer, const GLenum filter) const
+{
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, _framebuffer.id());
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffer);
+    glBlitFramebuffer(0,
+                      0,
+                      width(),
+                      height(),
+                      0,
+                      0,
+                      _outputWidth,
+                      _outputHeight,
+                      GL_COLOR_BUFFER_BIT,
+                      filter);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, _outputWidth, _outputHeight);
+}
+
+bool
+DynamicResolution::update(const double milliseconds)
+{
+    _smoothed = _measured ? _smoothed + (milliseconds - _smoothed) * kSmoothing : milliseconds;
+    _measured = true;
+    if (_cooldown > 0) {
+        _cooldown--;
+        return false;
+    }
+
+    const double load = _smoothed / _settings.budget;
+    if (load >= _settings.lowerThreshold and load <= _settings.upperThreshold) {
+        return false;
+    }
+
+    // Aim at the middle of the threshold band, pixel count grows with the scale squared
+    const double target = (_settings.lowerThreshold + _settings.upperThreshold) * 0.5;
+    const double desired = _scale * std::sqrt(target / std::max(load, 1e-3));
+    const float step = std::max(_settings.scaleStep, 1e-3f);
+    float next = std::round(static_cast<float>(desired) / step) * step;
+    if (load > _settings.upperThreshold) {
+        next = std::min(next, _scale - step);
+    } else {
+        next = std::max(next, _scale + step);
+    }
+    next = std::clamp(next, _settings.minScale, _settings.maxScale);
+    if (std::abs(next - _scale) < step * 0.5f) {
+        return false;
+    }
+
+    SPDLOG_INFO("Dynamic resolution scale {:.2f} -> {:.2f} ({:.2f} ms of {:.2f} ms budget)",
+                _scale,
+                next,
+                _smoothed,
+                _settings.budget);
+    _scale = next;
+    _cooldown = _settings.cooldownFrames;
+    return true;
+}
+
+float
+DynamicResolution::scale() const
+{
+    return _scale;
+}
+
+GLsizei
+DynamicResolution::width() const
+{
+    return std::min(scaled(_outputWidth, _scale), _color->desc().width);
+}
+
+GLsizei
+DynamicResolution::height() const
+{
+    return std::min(scaled(_outputHeight, _scale), _color->desc().height);
+}
+
+double
+DynamicResolution::milliseconds() const
+{
+    return _smoothed;
+}
+
+const RenderTarget&
+DynamicResolution::color() const
+{
+    return *_color;
+}
+
+} // namespace glesy
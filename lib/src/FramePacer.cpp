@@ -0,0 +1,51 @@
+#include "glesy/FramePacer.hpp"
+
+#include <thread>
+
+namespace glesy {
+
+FramePacer::FramePacer(const double maxFrameRate, const std::chrono::microseconds spinThreshold)
+    : _spinThreshold{spinThreshold}
+{
+    setMaxFrameRate(maxFrameRate);
+}
+
+void
+FramePacer::setMaxFrameRate(const double maxFrameRate)
+{
+    _maxFrameRate = maxFrameRate;
+    _period = (maxFrameRate > 0)
+                  ? std::chrono::duration_cast<Clock::duration>(
+                        std::chrono::duration<double>{1.0 / maxFrameRate})
+                  : Clock::duration::zero();
+    _next = Clock::now();
+}
+
+double
+FramePacer::maxFrameRate() const
+{
+    return _maxFrameRate;
+}
+
+void
+FramePacer::wait()
+{
+    if (_period == Clock::duration::zero()) {
+        return;
+    }
+
+    auto now = Clock::now();
+    if (now - _next > _period) {
+        // Missed more than one slot, start a new schedule
+        _next = now;
+    }
+    if (_next - now > _spinThreshold) {
+        std::this_thread::sleep_until(_next - _spinThreshold);
+    }
+    while (Clock::now() < _next) {
+        std::this_thread::yield();
+    }
+    _next += _period;
+}
+
+} // namespace glesy
@@ -0,0 +1,56 @@
+#include "glesy/Frustum.hpp"
+
+#include <glm/geometric.hpp>
+
+namespace glesy {
+
+Frustum
+Frustum::fromMatrix(const glm::mat4& matrix)
+{
+    const auto row = [&matrix](const int index) {
+        return glm::vec4{matrix[0][index], matrix[1][index], matrix[2][index], matrix[3][index]};
+    };
+
+    Frustum frustum;
+    frustum.planes[Left] = row(3) + row(0);
+    frustum.planes[Right] = row(3) - row(0);
+    frustum.planes[Bottom] = row(3) + row(1);
+    frustum.planes[Top] = row(3) - row(1);
+    frustum.planes[Near] = row(3) + row(2);
+    frustum.planes[Far] = row(3) - row(2);
+    for (auto& plane : frustum.planes) {
+        const float length = glm::length(glm::vec3{plane});
+        if (length > 0.0f) {
+            plane /= length;
+        }
+    }
+    return frustum;
+}
+
+bool
+Frustum::intersects(const glm::vec3& center, const float radius) const
+{
+    for (const auto& plane : planes) {
+        if (glm::dot(glm::vec3{plane}, center) + plane.w < -radius) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool
+Frustum::intersects(const glm::vec3& minimum, const glm::vec3& maximum) const
+{
+    for (const auto& plane : planes) {
+        // Test the box corner farthest along the plane normal
+        const glm::vec3 corner{plane.x >= 0.0f ? maximum.x : minimum.x,
+                               plane.y >= 0.0f ? maximum.y : minimum.y,
+                               plane.z >= 0.0f ? maximum.z : minimum.z};
+        if (glm::dot(glm::vec3{plane}, corner) + plane.w < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace glesy
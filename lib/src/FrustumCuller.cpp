@@ -0,0 +1,368 @@
+#include "glesy/FrustumCuller.hpp"
+#include "glesy/Parallel.hpp"
+
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) and defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#if defined(__GNUC__) and (defined(__x86_64__) or defined(__i386__))
+#define GLESY_CULL_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace glesy {
+
+namespace {
+
+constexpr std::size_t kBlock{8};
+// Padding objects have negative infinite radius, so they never pass the test
+constexpr float kPaddingRadius{-std::numeric_limits<float>::infinity()};
+
+struct CullPlanes {
+    float nx[Frustum::PlaneCount];
+    float ny[Frustum::PlaneCount];
+    float nz[Frustum::PlaneCount];
+    float w[Frustum::PlaneCount];
+    float ax[Frustum::PlaneCount];
+    float ay[Frustum::PlaneCount];
+    float az[Frustum::PlaneCount];
+};
+
+struct BoundsView {
+    const float* cx;
+    const float* cy;
+    const float* cz;
+    const float* r;
+    const float* ex;
+    const float* ey;
+    const float* ez;
+};
+
+CullPlanes
+makePlanes(const Frustum& frustum)
+{
+    CullPlanes planes{};
+    for (std::size_t index = 0; index < Frustum::PlaneCount; ++index) {
+        const auto& plane = frustum.planes[index];
+        planes.nx[index] = plane.x;
+        planes.ny[index] = plane.y;
+        planes.nz[index] = plane.z;
+        planes.w[index] = plane.w;
+        planes.ax[index] = std::abs(plane.x);
+        planes.ay[index] = std::abs(plane.y);
+        planes.az[index] = std::abs(plane.z);
+    }
+    return planes;
+}
+
+std::size_t
+emit(unsigned mask, const std::size_t base, std::uint32_t* output)
+{
+    std::size_t count{};
+    while (mask != 0) {
+        output[count++] = static_cast<std::uint32_t>(base + std::countr_zero(mask));
+        mask &= mask - 1;
+    }
+    return count;
+}
+
+/**
+ * Object passes plane when its center distance is not below minus the smaller of the sphere
+ * radius and the box extent projected onto the plane normal
+ */
+unsigned
+cullQuad(const CullPlanes& planes, const BoundsView& bounds, const std::size_t first)
+{
+#if defined(__SSE2__)
+    const __m128 cx = _mm_loadu_ps(bounds.cx + first);
+    const __m128 cy = _mm_loadu_ps(bounds.cy + first);
+    const __m128 cz = _mm_loadu_ps(bounds.cz + first);
+    const __m128 r = _mm_loadu_ps(bounds.r + first);
+    const __m128 ex = _mm_loadu_ps(bounds.ex + first);
+    const __m128 ey = _mm_loadu_ps(bounds.ey + first);
+    const __m128 ez = _mm_loadu_ps(bounds.ez + first);
+
+    __m128 margin = _mm_set1_ps(std::numeric_limits<float>::infinity());
+    for (std::size_t index = 0; index < Frustum::PlaneCount; ++index) {
+        const __m128 distance
+            = _mm_add_ps(_mm_add_ps(_mm_mul_ps(cx, _mm_set1_ps(planes.nx[index])),
+                                    _mm_mul_ps(cy, _mm_set1_ps(planes.ny[index]))),
+                         _mm_add_ps(_mm_mul_ps(cz, _mm_set1_ps(planes.nz[index])),
+                                    _mm_set1_ps(planes.w[index])));
+        const __m128 extent
+            = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ex, _mm_set1_ps(planes.ax[index])),
+                                    _mm_mul_ps(ey, _mm_set1_ps(planes.ay[index]))),
+                         _mm_mul_ps(ez, _mm_set1_ps(planes.az[index])));
+        margin = _mm_min_ps(margin, _mm_add_ps(distance, _mm_min_ps(r, extent)));
+    }
+    return static_cast<unsigned>(_mm_movemask_ps(_mm_cmpge_ps(margin, _mm_setzero_ps())));
+#elif defined(__ARM_NEON) and defined(__aarch64__)
+    const float32x4_t cx = vld1q_f32(bounds.cx + first);
+    const float32x4_t cy = vld1q_f32(bounds.cy + first);
+    const float32x4_t cz = vld1q_f32(bounds.cz + first);
+    const float32x4_t r = vld1q_f32(bounds.r + first);
+    const float32x4_t ex = vld1q_f32(bounds.ex + first);
+    const float32x4_t ey = vld1q_f32(bounds.ey + first);
+    const float32x4_t ez = vld1q_f32(bounds.ez + first);
+
+    float32x4_t margin = vdupq_n_f32(std::numeric_limits<float>::infinity());
+    for (std::size_t index = 0; index < Frustum::PlaneCount; ++index) {
+        float32x4_t distance = vdupq_n_f32(planes.w[index]);
+        distance = vfmaq_n_f32(distance, cx, planes.nx[index]);
+        distance = vfmaq_n_f32(distance, cy, planes.ny[index]);
+        distance = vfmaq_n_f32(distance, cz, planes.nz[index]);
+        float32x4_t extent = vmulq_n_f32(ex, planes.ax[index]);
+        extent = vfmaq_n_f32(extent, ey, planes.ay[index]);
+        extent = vfmaq_n_f32(extent, ez, planes.az[index]);
+        margin = vminq_f32(margin, vaddq_f32(distance, vminq_f32(r, extent)));
+    }
+    const uint32x4_t visible = vcgeq_f32(margin, vdupq_n_f32(0.0f));
+    return (vgetq_lane_u32(visible, 0) & 1U) | (vgetq_lane_u32(visible, 1) & 2U)
+           | (vgetq_lane_u32(visible, 2) & 4U) | (vgetq_lane_u32(visible, 3) & 8U);
+#else
+    unsigned mask{};
+    for (std::size_t lane = 0; lane < 4; ++lane) {
+        const std::size_t object = first + lane;
+        float margin = std::numeric_limits<float>::infinity();
+        for (std::size_t index = 0; index < Frustum::PlaneCount; ++index) {
+            const float distance = bounds.cx[object] * planes.nx[index]
+                                   + bounds.cy[object] * planes.ny[index]
+                                   + bounds.cz[object] * planes.nz[index] + planes.w[index];
+            const float extent = bounds.ex[object] * planes.ax[index]
+                                 + bounds.ey[object] * planes.ay[index]
+                                 + bounds.ez[object] * planes.az[index];
+            margin = std::min(margin, distance + std::min(bounds.r[object], extent));
+        }
+        mask |= (margin >= 0.0f) ? (1U << lane) : 0U;
+    }
+    return mask;
+#endif
+}
+
+std::size_t
+cullBlocks(const CullPlanes& planes,
+           const BoundsView& bounds,
+           const std::size_t first,
+           const std::size_t last,
+           std::uint32_t* output)
+{
+    std::size_t count{};
+    for (std::size_t block = first; block < last; ++block) {
+        const std::size_t base = block * kBlock;
+        const unsigned mask
+            = cullQuad(planes, bounds, base) | (cullQuad(planes, bounds, base + 4) << 4);
+        count += emit(mask, base, output + count);
+    }
+    return count;
+}
+
+#if defined(GLESY_CULL_AVX2)
+__attribute__((target("avx2,fma"))) std::size_t
+cullBlocksAvx2(const CullPlanes& planes,
+               const BoundsView& bounds,
+               const std::size_t first,
+               const std::size_t last,
+               std::uint32_t* output)
+{
+    std::size_t count{};
+    for (std::size_t block = first; block < last; ++block) {
+        const std::size_t base = block * kBlock;
+        const __m256 cx = _mm256_loadu_ps(bounds.cx + base);
+        const __m256 cy = _mm256_loadu_ps(bounds.cy + base);
+        const __m256 cz = _mm256_loadu_ps(bounds.cz + base);
+        const __m256 r = _mm256_loadu_ps(bounds.r + base);
+        const __m256 ex = _mm256_loadu_ps(bounds.ex + base);
+        const __m256 ey = _mm256_loadu_ps(bounds.ey + base);
+        const __m256 ez = _mm256_loadu_ps(bounds.ez + base);
+
+        __m256 margin = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+        for (std::size_t index = 0; index < Frustum::PlaneCount; ++index) {
+            __m256 distance = _mm256_fmadd_ps(
+                cz, _mm256_set1_ps(planes.nz[index]), _mm256_set1_ps(planes.w[index]));
+            distance = _mm256_fmadd_ps(cy, _mm256_set1_ps(planes.ny[index]), distance);
+            distance = _mm256_fmadd_ps(cx, _mm256_set1_ps(planes.nx[index]), distance);
+            __m256 extent = _mm256_mul_ps(ez, _mm256_set1_ps(planes.az[index]));
+            extent = _mm256_fmadd_ps(ey, _mm256_set1_ps(planes.ay[index]), extent);
+            extent = _mm256_fmadd_ps(ex, _mm256_set1_ps(planes.ax[index]), extent);
+            margin = _mm256_min_ps(margin, _mm256_add_ps(distance, _mm256_min_ps(r, extent)));
+        }
+        const auto mask = static_cast<unsigned>(
+            _mm256_movemask_ps(_mm256_cmp_ps(margin, _mm256_setzero_ps(), _CMP_GE_OQ)));
+        count += emit(mask, base, output + count);
+    }
+    return count;
+}
+#endif
+
+using CullBlocksFn = std::size_t (*)(
+    const CullPlanes&, const BoundsView&, std::size_t, std::size_t, std::uint32_t*);
+
+CullBlocksFn
+selectKernel()
+{
+#if defined(GLESY_CULL_AVX2)
+    if (__builtin_cpu_supports("avx2") and __builtin_cpu_supports("fma")) {
+        return cullBlocksAvx2;
+    }
+#endif
+    return cullBlocks;
+}
+
+} // namespace
+
+std::uint32_t
+FrustumCuller::addBox(const glm::vec3& minimum, const glm::vec3& maximum)
+{
+    const glm::vec3 extents = (maximum - minimum) * 0.5f;
+    return add((minimum + maximum) * 0.5f, glm::length(extents), extents);
+}
+
+std::uint32_t
+FrustumCuller::addSphere(const glm::vec3& center, const float radius)
+{
+    return add(center, radius, glm::vec3{radius});
+}
+
+std::uint32_t
+FrustumCuller::add(const glm::vec3& center, const float radius, const glm::vec3& extents)
+{
+    if (_count == _radius.size()) {
+        const std::size_t padded = (_count + kBlock) / kBlock * kBlock;
+        _centerX.resize(padded);
+        _centerY.resize(padded);
+        _centerZ.resize(padded);
+        _radius.resize(padded, kPaddingRadius);
+        _extentX.resize(padded);
+        _extentY.resize(padded);
+        _extentZ.resize(padded);
+    }
+    const auto index = static_cast<std::uint32_t>(_count++);
+    set(index, center, radius, extents);
+    return index;
+}
+
+void
+FrustumCuller::setBox(const std::uint32_t index, const glm::vec3& minimum, const glm::vec3& maximum)
+{
+    const glm::vec3 extents = (maximum - minimum) * 0.5f;
+    set(index, (minimum + maximum) * 0.5f, glm::length(extents), extents);
+}
+
+void
+FrustumCuller::setSphere(const std::uint32_t index, const glm::vec3& center, const float radius)
+{
+    set(index, center, radius, glm::vec3{radius});
+}
+
+void
+FrustumCuller::set(const std::uint32_t index,
+                   const glm::vec3& center,
+                   const float radius,
+                   const glm::vec3& extents)
+{
+    if (index >= _count) {
+        throw std::out_of_range{"Invalid culling object index"};
+    }
+    _centerX[index] = center.x;
+    _centerY[index] = center.y;
+    _centerZ[index] = center.z;
+    _radius[index] = radius;
+    _extentX[index] = extents.x;
+    _extentY[index] = extents.y;
+    _extentZ[index] = extents.z;
+}
+
+void
+FrustumCuller::reserve(const std::size_t count)
+{
+    const std::size_t padded = (count + kBlock - 1) / kBlock * kBlock;
+    _centerX.reserve(padded);
+    _centerY.reserve(padded);
+    _centerZ.reserve(padded);
+    _radius.reserve(padded);
+    _extentX.reserve(padded);
+    _extentY.reserve(padded);
+    _extentZ.reserve(padded);
+}
+
+void
+FrustumCuller::clear()
+{
+    _centerX.clear();
+    _centerY.clear();
+    _centerZ.clear();
+    _radius.clear();
+    _extentX.clear();
+    _extentY.clear();
+    _extentZ.clear();
+    _count = 0;
+}
+
+std::size_t
+FrustumCuller::size() const
+{
+    return _count;
+}
+
+std::size_t
+FrustumCuller::cull(const Frustum& frustum,
+                    std::vector<std::uint32_t>& visible,
+                    const std::size_t grain) const
+{
+    static const CullBlocksFn kernel = selectKernel();
+
+    const std::size_t blocks = _radius.size() / kBlock;
+    visible.resize(_radius.size());
+    if (blocks == 0) {
+        return 0;
+    }
+
+    const CullPlanes planes = makePlanes(frustum);
+    const BoundsView bounds{_centerX.data(),
+                            _centerY.data(),
+                            _centerZ.data(),
+                            _radius.data(),
+                            _extentX.data(),
+                            _extentY.data(),
+                            _extentZ.data()};
+
+    // Every chunk writes visible indices at its own offset, then chunks are compacted
+    auto& pool = ThreadPool::instance();
+    const std::size_t grainBlocks = std::max<std::size_t>(grain / kBlock, 1);
+    const std::size_t chunks
+        = std::clamp<std::size_t>((blocks + grainBlocks - 1) / grainBlocks, 1, pool.concurrency());
+    const std::size_t chunkBlocks = (blocks + chunks - 1) / chunks;
+    std::vector<std::size_t> chunkVisible(chunks);
+    pool.run(chunks, [&](const std::size_t chunk) {
+        const std::size_t first = chunk * chunkBlocks;
+        const std::size_t last = std::min(blocks, first + chunkBlocks);
+        if (first < last) {
+            chunkVisible[chunk]
+                = kernel(planes, bounds, first, last, visible.data() + first * kBlock);
+        }
+    });
+
+    std::size_t count = chunkVisible[0];
+    for (std::size_t chunk = 1; chunk < chunks; ++chunk) {
+        const auto source
+            = visible.begin() + static_cast<std::ptrdiff_t>(chunk * chunkBlocks * kBlock);
+        std::copy(source,
+                  source + static_cast<std::ptrdiff_t>(chunkVisible[chunk]),
+                  visible.begin() + static_cast<std::ptrdiff_t>(count));
+        count += chunkVisible[chunk];
+    }
+    visible.resize(count);
+    return count;
+}
+
+} // namespace glesy
@@ -0,0 +1,297 @@
+#include "glesy/GeometryHeap.hpp"
+
+#include "glesy/Indices.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace glesy {
+
+namespace {
+
+std::size_t
+grownCapacity(const std::size_t capacity, const std::size_t required)
+{
+    return std::max(required, capacity * 2);
+}
+
+} // namespace
+
+GeometryHeap::GeometryHeap(const VertexFormat& format,
+                           const GLsizei vertexCapacity,
+                           const GLsizei indexCapacity,
+                           const GLenum indexType)
+    : _format{format}
+    , _indexType{indexType}
+    , _indexSize{indexTypeSize(indexType)}
+    , _vertices{GL_ARRAY_BUFFER,
+                static_cast<GLsizeiptr>(vertexCapacity) * format.stride,
+                nullptr}
+    , _vertexAllocator{static_cast<std::size_t>(vertexCapacity)}
+    , _indexAllocator{static_cast<std::size_t>(indexCapacity)}
+{
+    if (format.stride <= 0 or vertexCapacity < 0 or indexCapacity < 0) {
+        throw std::invalid_argument{"Invalid geometry heap configuration"};
+    }
+    _indices = makeIndexBuffer(static_cast<std::size_t>(indexCapacity));
+    attachBuffers();
+}
+
+GeometryHeap::Handle
+GeometryHeap::allocate(const void* vertices,
+                       const GLsizeiptr verticesSize,
+                       const std::span<const GLuint> indices)
+{
+    if (verticesSize <= 0 or verticesSize % _format.stride != 0 or indices.empty()) {
+        throw std::invalid_argument{"Invalid mesh data"};
+    }
+    const auto vertexCount = static_cast<std::size_t>(verticesSize / _format.stride);
+    if (vertexCount - 1 > primitiveRestartIndex(_indexType)) {
+        throw std::invalid_argument{"Mesh has too many vertices for heap index type"};
+    }
+
+    auto vertexOffset = _vertexAllocator.allocate(vertexCount);
+    auto indexOffset = _indexAllocator.allocate(indices.size());
+    if (vertexOffset == RangeAllocator::kInvalidOffset
+        or indexOffset == RangeAllocator::kInvalidOffset) {
+        // Grow only the exhausted buffer, the other one has room for the mesh
+        std::size_t vertexCapacity = _vertexAllocator.capacity();
+        std::size_t indexCapacity = _indexAllocator.capacity();
+        if (vertexOffset != RangeAllocator::kInvalidOffset) {
+            _vertexAllocator.free(vertexOffset, vertexCount);
+        } else {
+            vertexCapacity = grownCapacity(vertexCapacity, _vertexAllocator.used() + vertexCount);
+        }
+        if (indexOffset != RangeAllocator::kInvalidOffset) {
+            _indexAllocator.free(indexOffset, indices.size());
+        } else {
+            indexCapacity = grownCapacity(indexCapacity, _indexAllocator.used() + indices.size());
+        }
+        reserve(vertexCapacity, indexCapacity);
+        vertexOffset = _vertexAllocator.allocate(vertexCount);
+        indexOffset = _indexAllocator.allocate(indices.size());
+        if (vertexOffset == RangeAllocator::kInvalidOffset
+            or indexOffset == RangeAllocator::kInvalidOffset) {
+            // Free space is fragmented, compact it to fit the mesh
+            if (vertexOffset != RangeAllocator::kInvalidOffset) {
+                _vertexAllocator.free(vertexOffset, vertexCount);
+            }
+            if (indexOffset != RangeAllocator::kInvalidOffset) {
+                _indexAllocator.free(indexOffset, indices.size());
+            }
+            defragment();
+            vertexOffset = _vertexAllocator.allocate(vertexCount);
+            indexOffset = _indexAllocator.allocate(indices.size());
+        }
+    }
+
+    _vertices.setSubData(static_cast<GLintptr>(vertexOffset) * _format.stride,
+                         verticesSize,
+                         vertices);
+    const auto packed = packIndices(indices, _indexType);
+    _indices.setSubData(static_cast<GLintptr>(indexOffset * _indexSize),
+                        static_cast<GLsizeiptr>(packed.size()),
+                        packed.data());
+
+    Handle handle{};
+    if (_freeHandles.empty()) {
+        handle = static_cast<Handle>(_slots.size());
+        _slots.emplace_back();
+    } else {
+        handle = _freeHandles.back();
+        _freeHandles.pop_back();
+    }
+    _slots[handle] = Slot{.range = {.baseVertex = static_cast<GLint>(vertexOffset),
+                                    .vertexCount = static_cast<GLsizei>(vertexCount),
+                                    .firstIndex = static_cast<GLsizei>(indexOffset),
+                                    .indexCount = static_cast<GLsizei>(indices.size())},
+                          .live = true};
+    return handle;
+}
+
+void
+GeometryHeap::release(const Handle handle)
+{
+    if (not contains(handle)) {
+        return;
+    }
+    auto& slot = _slots[handle];
+    _vertexAllocator.free(static_cast<std::size_t>(slot.range.baseVertex),
+                          static_cast<std::size_t>(slot.range.vertexCount));
+    _indexAllocator.free(static_cast<std::size_t>(slot.range.firstIndex),
+                         static_cast<std::size_t>(slot.range.indexCount));
+    slot = {};
+    _freeHandles.push_back(handle);
+}
+
+bool
+GeometryHeap::contains(const Handle handle) const
+{
+    return handle < _slots.size() and _slots[handle].live;
+}
+
+const GeometryRange&
+GeometryHeap::range(const Handle handle) const
+{
+    if (not contains(handle)) {
+        throw std::out_of_range{"Invalid geometry heap handle"};
+    }
+    return _slots[handle].range;
+}
+
+GLintptr
+GeometryHeap::indexOffset(const Handle handle) const
+{
+    return static_cast<GLintptr>(static_cast<std::size_t>(range(handle).firstIndex) * _indexSize);
+}
+
+void
+GeometryHeap::bind() const
+{
+    _vertexArray.bind();
+}
+
+void
+GeometryHeap::draw(const Handle handle, const GLenum primitive) const
+{
+    const auto& meshRange = range(handle);
+    draw(handle,
+         MeshLod{.indexCount = static_cast<GLuint>(meshRange.indexCount)},
+         primitive);
+}
+
+void
+GeometryHeap::draw(const Handle handle, const MeshLod& lod, const GLenum primitive) const
+{
+    const auto& meshRange = range(handle);
+    const auto offset = (static_cast<std::size_t>(meshRange.firstIndex) + lod.firstIndex)
+                        * _indexSize;
+    glDrawElementsBaseVertex(primitive,
+                             static_cast<GLsizei>(lod.indexCount),
+                             _indexType,
+                             reinterpret_cast<const void*>(offset),
+                             meshRange.baseVertex);
+}
+
+void
+GeometryHeap::defragment()
+{
+    const auto stride = static_cast<std::size_t>(_format.stride);
+    Buffer vertices{GL_ARRAY_BUFFER,
+                    static_cast<GLsizeiptr>(_vertexAllocator.capacity() * stride),
+                    nullptr};
+    auto indices = makeIndexBuffer(_indexAllocator.capacity());
+
+    _vertexAllocator.reset();
+    _indexAllocator.reset();
+    for (auto& slot : _slots) {
+        if (not slot.live) {
+            continue;
+        }
+        auto& meshRange = slot.range;
+        const auto vertexCount = static_cast<std::size_t>(meshRange.vertexCount);
+        const auto indexCount = static_cast<std::size_t>(meshRange.indexCount);
+        // Single free block is consumed sequentially, so meshes are packed without gaps
+        const auto vertexOffset = _vertexAllocator.allocate(vertexCount);
+        const auto indexOffset = _indexAllocator.allocate(indexCount);
+        vertices.copySubData(_vertices,
+                             static_cast<GLintptr>(meshRange.baseVertex * stride),
+                             static_cast<GLintptr>(vertexOffset * stride),
+                             static_cast<GLsizeiptr>(vertexCount * stride));
+        indices.copySubData(_indices,
+                            static_cast<GLintptr>(meshRange.firstIndex * _indexSize),
+                            static_cast<GLintptr>(indexOffset * _indexSize),
+                            static_cast<GLsizeiptr>(indexCount * _indexSize));
+        meshRange.baseVertex = static_cast<GLint>(vertexOffset);
+        meshRange.firstIndex = static_cast<GLsizei>(indexOffset);
+    }
+
+    _vertices = std::move(vertices);
+    _indices = std::move(indices);
+    attachBuffers();
+}
+
+float
+GeometryHeap::fragmentation() const
+{
+    return std::max(_vertexAllocator.fragmentation(), _indexAllocator.fragmentation());
+}
+
+const VertexFormat&
+GeometryHeap::format() const
+{
+    return _format;
+}
+
+GLenum
+GeometryHeap::indexType() const
+{
+    return _indexType;
+}
+
+const VertexArray&
+GeometryHeap::vertexArray() const
+{
+    return _vertexArray;
+}
+
+const Buffer&
+GeometryHeap::vertexBuffer() const
+{
+    return _vertices;
+}
+
+const Buffer&
+GeometryHeap::indexBuffer() const
+{
+    return _indices;
+}
+
+std::size_t
+GeometryHeap::meshCount() const
+{
+    return _slots.size() - _freeHandles.size();
+}
+
+void
+GeometryHeap::reserve(const std::size_t vertexCapacity, const std::size_t indexCapacity)
+{
+    SPDLOG_INFO("Grow geometry heap: vertices {} -> {}, indices {} -> {}",
+                _vertexAllocator.capacity(),
+                vertexCapacity,
+                _indexAllocator.capacity(),
+                indexCapacity);
+
+    const auto stride = static_cast<std::size_t>(_format.stride);
+    if (vertexCapacity > _vertexAllocator.capacity()) {
+        Buffer vertices{GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertexCapacity * stride), nullptr};
+        vertices.copySubData(_vertices, 0, 0, _vertices.size());
+        _vertices = std::move(vertices);
+        _vertexAllocator.grow(vertexCapacity);
+    }
+    if (indexCapacity > _indexAllocator.capacity()) {
+        auto indices = makeIndexBuffer(indexCapacity);
+        indices.copySubData(_indices, 0, 0, _indices.size());
+        _indices = std::move(indices);
+        _indexAllocator.grow(indexCapacity);
+    }
+    attachBuffers();
+}
+
+Buffer
+GeometryHeap::makeIndexBuffer(const std::size_t capacity) const
+{
+    return Buffer{
+        GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(capacity * _indexSize), nullptr};
+}
+
+void
+GeometryHeap::attachBuffers()
+{
+    _vertexArray.setVertexBuffer(_vertices, _format);
+    _vertexArray.setIndexBuffer(_indices);
+}
+
+} // namespace glesy
@@ -0,0 +1,555 @@
+#include "glesy/MeshData.hpp"
+#include "glesy/MappedFile.hpp"
+#include "glesy/Parallel.hpp"
+
+#include "Json.hpp"
+
+#include <glm/mat3x3.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/geometric.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+
+namespace glesy {
+
+namespace {
+
+constexpr std::uint32_t kGlbMagic{0x46546C67};     // "glTF"
+constexpr std::uint32_t kGlbJsonChunk{0x4E4F534A}; // "JSON"
+constexpr std::uint32_t kGlbBinChunk{0x004E4942};  // "BIN"
+constexpr std::size_t kGlbHeaderSize{12};
+constexpr std::size_t kGlbChunkHeaderSize{8};
+constexpr std::size_t kModeTriangles{4};
+
+enum ComponentType {
+    kByte = 5120,
+    kUnsignedByte = 5121,
+    kShort = 5122,
+    kUnsignedShort = 5123,
+    kUnsignedInt = 5125,
+    kFloat = 5126,
+};
+
+struct Document {
+    JsonValue json;
+    std::vector<std::span<const std::byte>> buffers;
+    std::vector<MappedFile> files;
+    std::vector<std::filesystem::path> paths;
+    std::vector<std::vector<std::byte>> decoded;
+};
+
+struct Accessor {
+    const std::byte* data{};
+    std::size_t count{};
+    std::size_t stride{};
+    std::size_t componentType{};
+    std::size_t components{};
+    bool normalized{};
+};
+
+struct PrimitiveInstance {
+    const JsonValue* primitive{};
+    glm::mat4 transform{1.0f};
+};
+
+struct VertexHash {
+    std::size_t
+    operator()(const MeshVertex& vertex) const noexcept
+    {
+        std::uint32_t words[sizeof(MeshVertex) / sizeof(std::uint32_t)];
+        std::memcpy(words, &vertex, sizeof(words));
+        std::uint64_t hash = 0xCBF29CE484222325ULL;
+        for (const auto word : words) {
+            hash = (hash ^ word) * 0x100000001B3ULL;
+        }
+        return static_cast<std::size_t>(hash ^ (hash >> 29U));
+    }
+};
+
+/**
+ * Bitwise vertex equality consistent with @c VertexHash (float comparison treats -0 and +0 as
+ * equal while their bits differ, and never matches NaN to itself)
+ */
+struct VertexEqual {
+    bool
+    operator()(const MeshVertex& lhs, const MeshVertex& rhs) const noexcept
+    {
+        return std::memcmp(&lhs, &rhs, sizeof(MeshVertex)) == 0;
+    }
+};
+
+static_assert(sizeof(MeshVertex) == 8 * sizeof(float), "MeshVertex must have no padding");
+
+std::uint32_t
+readU32(const std::byte* data)
+{
+    std::uint32_t value{};
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+std::vector<std::byte>
+decodeBase64(const std::string_view text)
+{
+    const auto decode = [](const char ch) -> int {
+        if (ch >= 'A' and ch <= 'Z') {
+            return ch - 'A';
+        }
+        if (ch >= 'a' and ch <= 'z') {
+            return ch - 'a' + 26;
+        }
+        if (ch >= '0' and ch <= '9') {
+            return ch - '0' + 52;
+        }
+        if (ch == '+') {
+            return 62;
+        }
+        if (ch == '/') {
+            return 63;
+        }
+        return -1;
+    };
+
+    std::vector<std::byte> out;
+    out.reserve(text.size() / 4 * 3);
+    std::uint32_t accumulator{};
+    int bits{};
+    for (const char ch : text) {
+        if (ch == '=') {
+            break;
+        }
+        const int value = decode(ch);
+        if (value < 0) {
+            throw std::runtime_error{"Invalid glTF base64 data"};
+        }
+        accumulator = (accumulator << 6U) | static_cast<std::uint32_t>(value);
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            out.push_back(static_cast<std::byte>((accumulator >> bits) & 0xFFU));
+        }
+    }
+    return out;
+}
+
+std::size_t
+componentSize(const std::size_t componentType)
+{
+    switch (componentType) {
+    case kByte:
+    case kUnsignedByte:
+        return 1;
+    case kShort:
+    case kUnsignedShort:
+        return 2;
+    case kUnsignedInt:
+    case kFloat:
+        return 4;
+    default:
+        throw std::runtime_error{"Unsupported glTF component type"};
+    }
+}
+
+std::size_t
+componentCount(const std::string& type)
+{
+    if (type == "SCALAR") {
+        return 1;
+    }
+    if (type == "VEC2") {
+        return 2;
+    }
+    if (type == "VEC3") {
+        return 3;
+    }
+    if (type == "VEC4") {
+        return 4;
+    }
+    throw std::runtime_error{"Unsupported glTF accessor type"};
+}
+
+Document
+openDocument(const std::filesystem::path& filePath)
+{
+    Document document;
+    MappedFile file{filePath};
+    const auto bytes = file.bytes();
+
+    std::span<const std::byte> binChunk;
+    if (bytes.size() >= kGlbHeaderSize and readU32(bytes.data()) == kGlbMagic) {
+        std::string_view json;
+        std::size_t offset{kGlbHeaderSize};
+        while (offset + kGlbChunkHeaderSize <= bytes.size()) {
+            const std::size_t length = readU32(bytes.data() + offset);
+            const std::uint32_t type = readU32(bytes.data() + offset + 4);
+            offset += kGlbChunkHeaderSize;
+            if (offset + length > bytes.size()) {
+                throw std::runtime_error{"Truncated GLB chunk"};
+            }
+            if (type == kGlbJsonChunk) {
+                json = {reinterpret_cast<const char*>(bytes.data() + offset), length};
+            } else if (type == kGlbBinChunk and binChunk.empty()) {
+                binChunk = bytes.subspan(offset, length);
+            }
+            offset += length;
+        }
+        document.json = JsonValue::parse(json);
+    } else {
+        document.json = JsonValue::parse(file.text());
+    }
+    document.files.push_back(std::move(file));
+    document.paths.push_back(filePath);
+
+    const auto& buffers = document.json["buffers"].items();
+    document.decoded.reserve(buffers.size());
+    for (const auto& buffer : buffers) {
+        const auto& uri = buffer["uri"].asString();
+        if (uri.empty()) {
+            document.buffers.push_back(binChunk);
+        } else if (uri.starts_with("data:")) {
+            const auto comma = uri.find(',');
+            if (comma == std::string::npos) {
+                throw std::runtime_error{"Invalid glTF data URI"};
+            }
+            document.decoded.push_back(decodeBase64(std::string_view{uri}.substr(comma + 1)));
+            document.buffers.emplace_back(document.decoded.back());
+        } else {
+            document.paths.push_back(filePath.parent_path() / uri);
+            document.files.emplace_back(document.paths.back());
+            document.buffers.push_back(document.files.back().bytes());
+        }
+        if (document.buffers.back().size() < buffer["byteLength"].asIndex()) {
+            throw std::runtime_error{"glTF buffer is shorter than declared"};
+        }
+    }
+    return document;
+}
+
+Accessor
+openAccessor(const Document& document, const std::size_t index)
+{
+    const auto& json = document.json["accessors"][index];
+    if (json.isNull()) {
+        throw std::runtime_error{"Invalid glTF accessor reference"};
+    }
+    if (json.find("sparse") != nullptr) {
+        throw std::runtime_error{"Sparse glTF accessors are not supported"};
+    }
+
+    Accessor accessor;
+    accessor.count = json["count"].asIndex();
+    accessor.componentType = json["componentType"].asIndex();
+    accessor.components = componentCount(json["type"].asString());
+    accessor.normalized = json["normalized"].asBool();
+
+    const std::size_t elementSize = componentSize(accessor.componentType) * accessor.components;
+    const auto* viewRef = json.find("bufferView");
+    if (viewRef == nullptr) {
+        // Accessor without buffer view is filled with zeros
+        accessor.stride = elementSize;
+        return accessor;
+    }
+
+    const auto& view = document.json["bufferViews"][viewRef->asIndex()];
+    const std::size_t bufferIndex = view["buffer"].asIndex();
+    if (view.isNull() or bufferIndex >= document.buffers.size()) {
+        throw std::runtime_error{"Invalid glTF buffer view reference"};
+    }
+    const auto buffer = document.buffers[bufferIndex];
+    const std::size_t viewOffset = view["byteOffset"].asIndex();
+    const std::size_t viewLength = view["byteLength"].asIndex();
+    const std::size_t offset = json["byteOffset"].asIndex();
+    accessor.stride = view["byteStride"].asIndex(elementSize);
+
+    const std::size_t required
+        = (accessor.count > 0) ? offset + accessor.stride * (accessor.count - 1) + elementSize : 0;
+    if (viewOffset + viewLength > buffer.size() or required > viewLength) {
+        throw std::runtime_error{"glTF accessor is out of buffer bounds"};
+    }
+    accessor.data = buffer.data() + viewOffset + offset;
+    return accessor;
+}
+
+template<typename T>
+T
+readRaw(const std::byte* data)
+{
+    T value{};
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+float
+readFloat(const Accessor& accessor, const std::size_t element, const std::size_t component)
+{
+    if (accessor.data == nullptr) {
+        return 0.0f;
+    }
+    const std::byte* data = accessor.data + element * accessor.stride
+                            + component * componentSize(accessor.componentType);
+    switch (accessor.componentType) {
+    case kFloat:
+        return readRaw<float>(data);
+    case kUnsignedByte: {
+        const auto value = static_cast<float>(readRaw<std::uint8_t>(data));
+        return accessor.normalized ? value / 255.0f : value;
+    }
+    case kUnsignedShort: {
+        const auto value = static_cast<float>(readRaw<std::uint16_t>(data));
+        return accessor.normalized ? value / 65535.0f : value;
+    }
+    case kByte: {
+        const auto value = static_cast<float>(readRaw<std::int8_t>(data));
+        return accessor.normalized ? std::max(value / 127.0f, -1.0f) : value;
+    }
+    case kShort: {
+        const auto value = static_cast<float>(readRaw<std::int16_t>(data));
+        return accessor.normalized ? std::max(value / 32767.0f, -1.0f) : value;
+    }
+    default:
+        return static_cast<float>(readRaw<std::uint32_t>(data));
+    }
+}
+
+GLuint
+readIndex(const Accessor& accessor, const std::size_t element)
+{
+    if (accessor.data == nullptr) {
+        return 0;
+    }
+    const std::byte* data = accessor.data + element * accessor.stride;
+    switch (accessor.componentType) {
+    case kUnsignedByte:
+        return readRaw<std::uint8_t>(data);
+    case kUnsignedShort:
+        return readRaw<std::uint16_t>(data);
+    case kUnsignedInt:
+        return readRaw<std::uint32_t>(data);
+    default:
+        throw std::runtime_error{"Invalid glTF index component type"};
+    }
+}
+
+glm::mat4
+nodeTransform(const JsonValue& node)
+{
+    glm::mat4 transform{1.0f};
+    if (const auto* matrix = node.find("matrix"); matrix != nullptr and matrix->size() == 16) {
+        for (int column = 0; column < 4; ++column) {
+            for (int row = 0; row < 4; ++row) {
+                const auto index = static_cast<std::size_t>(column * 4 + row);
+                transform[column][row] = static_cast<float>((*matrix)[index].asNumber());
+            }
+        }
+        return transform;
+    }
+
+    const auto component =
+        [&node](const char* name, const std::size_t index, const double fallback) {
+            return static_cast<float>(node[name][index].asNumber(fallback));
+        };
+    const float x = component("rotation", 0, 0.0);
+    const float y = component("rotation", 1, 0.0);
+    const float z = component("rotation", 2, 0.0);
+    const float w = component("rotation", 3, 1.0);
+    const float sx = component("scale", 0, 1.0);
+    const float sy = component("scale", 1, 1.0);
+    const float sz = component("scale", 2, 1.0);
+
+    // T * R * S composed directly (rotation is unit quaternion)
+    transform[0] = glm::vec4{1.0f - 2.0f * (y * y + z * z),
+                             2.0f * (x * y + z * w),
+                             2.0f * (x * z - y * w),
+                             0.0f}
+                   * sx;
+    transform[1] = glm::vec4{2.0f * (x * y - z * w),
+                             1.0f - 2.0f * (x * x + z * z),
+                             2.0f * (y * z + x * w),
+                             0.0f}
+                   * sy;
+    transform[2] = glm::vec4{2.0f * (x * z + y * w),
+                             2.0f * (y * z - x * w),
+                             1.0f - 2.0f * (x * x + y * y),
+                             0.0f}
+                   * sz;
+    transform[3] = glm::vec4{component("translation", 0, 0.0),
+                             component("translation", 1, 0.0),
+                             component("translation", 2, 0.0),
+                             1.0f};
+    return transform;
+}
+
+std::vector<PrimitiveInstance>
+collectPrimitives(const JsonValue& json)
+{
+    const auto& nodes = json["nodes"];
+    const auto& meshes = json["meshes"];
+
+    std::vector<std::size_t> roots;
+    if (const auto& scenes = json["scenes"]; scenes.size() > 0) {
+        for (const auto& node : scenes[json["scene"].asIndex()]["nodes"].items()) {
+            roots.push_back(node.asIndex());
+        }
+    } else {
+        std::vector<bool> isChild(nodes.size(), false);
+        for (const auto& node : nodes.items()) {
+            for (const auto& child : node["children"].items()) {
+                if (child.asIndex() < isChild.size()) {
+                    isChild[child.asIndex()] = true;
+                }
+            }
+        }
+        for (std::size_t index = 0; index < nodes.size(); ++index) {
+            if (not isChild[index]) {
+                roots.push_back(index);
+            }
+        }
+    }
+
+    std::vector<PrimitiveInstance> instances;
+    std::vector<std::pair<std::size_t, glm::mat4>> stack;
+    for (const auto root : roots) {
+        stack.emplace_back(root, glm::mat4{1.0f});
+    }
+    std::size_t visited{};
+    while (not stack.empty()) {
+        const auto [index, parent] = stack.back();
+        stack.pop_back();
+        if (++visited > nodes.size() * nodes.size() + 1) {
+            throw std::runtime_error{"glTF node hierarchy contains cycles"};
+        }
+
+        const auto& node = nodes[index];
+        const glm::mat4 world = parent * nodeTransform(node);
+        if (const auto* mesh = node.find("mesh"); mesh != nullptr) {
+            for (const auto& primitive : meshes[mesh->asIndex()]["primitives"].items()) {
+                instances.push_back({&primitive, world});
+            }
+        }
+        for (const auto& child : node["children"].items()) {
+            stack.emplace_back(child.asIndex(), world);
+        }
+    }
+    return instances;
+}
+
+MeshData
+loadPrimitive(const Document& document, const PrimitiveInstance& instance)
+{
+    const auto& primitive = *instance.primitive;
+    if (primitive["mode"].asIndex(kModeTriangles) != kModeTriangles) {
+        SPDLOG_WARN("Skip glTF primitive: only triangle lists are supported");
+        return {};
+    }
+
+    const auto& attributes = primitive["attributes"];
+    const auto* positionRef = attributes.find("POSITION");
+    if (positionRef == nullptr) {
+        return {};
+    }
+    const Accessor positions = openAccessor(document, positionRef->asIndex());
+    const auto* normalRef = attributes.find("NORMAL");
+    const Accessor normals = (normalRef != nullptr) ? openAccessor(document, normalRef->asIndex())
+                                                    : Accessor{};
+    const auto* texCoordRef = attributes.find("TEXCOORD_0");
+    const Accessor texCoords = (texCoordRef != nullptr)
+                                   ? openAccessor(document, texCoordRef->asIndex())
+                                   : Accessor{};
+    const auto* indexRef = primitive.find("indices");
+    const Accessor indices = (indexRef != nullptr) ? openAccessor(document, indexRef->asIndex())
+                                                   : Accessor{};
+    const std::size_t indexCount = (indexRef != nullptr) ? indices.count : positions.count;
+
+    const glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3{instance.transform}));
+
+    MeshData mesh;
+    std::unordered_map<MeshVertex, GLuint, VertexHash, VertexEqual> unique;
+    unique.reserve(positions.count);
+    mesh.indices.reserve(indexCount);
+    for (std::size_t corner = 0; corner < indexCount; ++corner) {
+        const std::size_t index = (indexRef != nullptr) ? readIndex(indices, corner) : corner;
+        if (index >= positions.count) {
+            throw std::runtime_error{"glTF index is out of range"};
+        }
+
+        MeshVertex vertex{};
+        const glm::vec4 position = instance.transform
+                                   * glm::vec4{readFloat(positions, index, 0),
+                                               readFloat(positions, index, 1),
+                                               readFloat(positions, index, 2),
+                                               1.0f};
+        vertex.position = glm::vec3{position.x, position.y, position.z};
+        if (normalRef != nullptr and index < normals.count) {
+            const glm::vec3 normal = normalMatrix
+                                     * glm::vec3{readFloat(normals, index, 0),
+                                                 readFloat(normals, index, 1),
+                                                 readFloat(normals, index, 2)};
+            if (const float length = glm::length(normal); length > 0.0f) {
+                vertex.normal = normal / length;
+            }
+        }
+        if (texCoordRef != nullptr and index < texCoords.count) {
+            vertex.texCoord
+                = glm::vec2{readFloat(texCoords, index, 0), readFloat(texCoords, index, 1)};
+        }
+
+        const auto [it, inserted]
+            = unique.try_emplace(vertex, static_cast<GLuint>(mesh.vertices.size()));
+        if (inserted) {
+            mesh.vertices.push_back(vertex);
+        }
+        mesh.indices.push_back(it->second);
+    }
+    // Drop incomplete trailing triangle
+    mesh.indices.resize(mesh.indices.size() / 3 * 3);
+    return mesh;
+}
+
+} // namespace
+
+MeshData
+MeshData::loadGltf(const std::filesystem::path& filePath)
+{
+    const Document document = openDocument(filePath);
+    const auto instances = collectPrimitives(document.json);
+
+    auto& pool = ThreadPool::instance();
+    std::vector<MeshData> parts(instances.size());
+    pool.run(instances.size(), [&](const std::size_t index) {
+        parts[index] = loadPrimitive(document, instances[index]);
+    });
+
+    std::vector<std::size_t> vertexOffsets(parts.size());
+    std::vector<std::size_t> indexOffsets(parts.size());
+    std::size_t vertexCount{};
+    std::size_t indexCount{};
+    for (std::size_t index = 0; index < parts.size(); ++index) {
+        vertexOffsets[index] = vertexCount;
+        indexOffsets[index] = indexCount;
+        vertexCount += parts[index].vertices.size();
+        indexCount += parts[index].indices.size();
+    }
+
+    MeshData mesh;
+    mesh.vertices.resize(vertexCount);
+    mesh.indices.resize(indexCount);
+    pool.run(parts.size(), [&](const std::size_t index) {
+        const auto& part = parts[index];
+        std::ranges::copy(part.vertices, mesh.vertices.begin() + vertexOffsets[index]);
+        const auto base = static_cast<GLuint>(vertexOffsets[index]);
+        std::ranges::transform(part.indices,
+                               mesh.indices.begin() + indexOffsets[index],
+                               [base](const GLuint value) { return value + base; });
+    });
+    mesh.files = document.paths;
+    return mesh;
+}
+
+} // namespace glesy
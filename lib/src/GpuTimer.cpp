@@ -0,0 +1,88 @@
+#include "glesy/GpuTimer.hpp"
+
+#include <algorithm>
+
+namespace glesy {
+
+GpuTimer::GpuTimer(const std::size_t latency)
+    : _queries(std::max<std::size_t>(latency, 1) * 2)
+{
+    glGenQueries(static_cast<GLsizei>(_queries.size()), _queries.data());
+}
+
+GpuTimer::~GpuTimer()
+{
+    glDeleteQueries(static_cast<GLsizei>(_queries.size()), _queries.data());
+}
+
+void
+GpuTimer::begin()
+{
+    collect();
+    if (_pending == pairs()) {
+        return;
+    }
+    glQueryCounter(_queries[_head * 2], GL_TIMESTAMP);
+    _active = true;
+}
+
+void
+GpuTimer::end()
+{
+    if (not _active) {
+        return;
+    }
+    glQueryCounter(_queries[_head * 2 + 1], GL_TIMESTAMP);
+    _active = false;
+    _head = (_head + 1) % pairs();
+    _pending++;
+}
+
+double
+GpuTimer::milliseconds() const
+{
+    return _milliseconds;
+}
+
+bool
+GpuTimer::ready() const
+{
+    return _ready;
+}
+
+std::size_t
+GpuTimer::samples() const
+{
+    return _samples;
+}
+
+std::size_t
+GpuTimer::pairs() const
+{
+    return _queries.size() / 2;
+}
+
+void
+GpuTimer::collect()
+{
+    // Queries finish in submission order, so stop at the first unavailable one
+    while (_pending > 0) {
+        const std::size_t tail = (_head + pairs() - _pending) % pairs();
+        GLint available{};
+        // The end timestamp is written after the start one
+        glGetQueryObjectiv(_queries[tail * 2 + 1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available == GL_FALSE) {
+            break;
+        }
+        GLuint64 start{};
+        GLuint64 end{};
+        glGetQueryObjectui64v(_queries[tail * 2], GL_QUERY_RESULT, &start);
+        glGetQueryObjectui64v(_queries[tail * 2 + 1], GL_QUERY_RESULT, &end);
+        _milliseconds = static_cast<double>(end - start) * 1e-6;
+        _ready = true;
+        _samples++;
+        _pending--;
+    }
+}
+
+} // namespace glesy
@@ -0,0 +1,199 @@
+#include "glesy/Indices.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+namespace glesy {
+
+namespace {
+
+constexpr std::size_t kNoTriangle{~std::size_t{0}};
+
+template<typename T>
+void
+packAs(const std::span<const GLuint> indices, std::byte* out)
+{
+    constexpr auto kRestart = static_cast<T>(~T{0});
+    for (const GLuint index : indices) {
+        const T value = (index == kPrimitiveRestartIndex) ? kRestart : static_cast<T>(index);
+        std::memcpy(out, &value, sizeof(T));
+        out += sizeof(T);
+    }
+}
+
+std::uint64_t
+edgeKey(const GLuint from, const GLuint to)
+{
+    return (static_cast<std::uint64_t>(from) << 32U) | to;
+}
+
+/**
+ * Triangles sorted by directed edges in their winding order
+ */
+class EdgeIndex {
+public:
+    explicit EdgeIndex(const std::span<const GLuint> indices)
+    {
+        _edges.reserve(indices.size());
+        for (std::size_t triangle = 0; triangle < indices.size() / 3; ++triangle) {
+            const GLuint* v = &indices[triangle * 3];
+            _edges.emplace_back(edgeKey(v[0], v[1]), triangle);
+            _edges.emplace_back(edgeKey(v[1], v[2]), triangle);
+            _edges.emplace_back(edgeKey(v[2], v[0]), triangle);
+        }
+        std::ranges::sort(_edges);
+    }
+
+    /**
+     * Find not yet emitted triangle having directed edge from -> to
+     */
+    [[nodiscard]] std::size_t
+    find(const GLuint from, const GLuint to, const std::vector<bool>& emitted) const
+    {
+        const auto key = edgeKey(from, to);
+        auto it = std::ranges::lower_bound(
+            _edges, key, {}, &std::pair<std::uint64_t, std::size_t>::first);
+        for (; it != _edges.end() and it->first == key; ++it) {
+            if (not emitted[it->second]) {
+                return it->second;
+            }
+        }
+        return kNoTriangle;
+    }
+
+private:
+    std::vector<std::pair<std::uint64_t, std::size_t>> _edges;
+};
+
+/**
+ * Get vertex of triangle opposite to the edge
+ */
+GLuint
+thirdVertex(const GLuint* triangle, const GLuint a, const GLuint b)
+{
+    for (std::size_t corner = 0; corner < 3; ++corner) {
+        if (triangle[corner] != a and triangle[corner] != b) {
+            return triangle[corner];
+        }
+    }
+    return triangle[0];
+}
+
+} // namespace
+
+GLenum
+selectIndexType(const std::size_t vertexCount, const bool primitiveRestart)
+{
+    const std::size_t reserved = primitiveRestart ? 1 : 0;
+    if (vertexCount + reserved <= std::size_t{UINT8_MAX} + 1) {
+        return GL_UNSIGNED_BYTE;
+    }
+    if (vertexCount + reserved <= std::size_t{UINT16_MAX} + 1) {
+        return GL_UNSIGNED_SHORT;
+    }
+    return GL_UNSIGNED_INT;
+}
+
+std::size_t
+indexTypeSize(const GLenum type)
+{
+    switch (type) {
+    case GL_UNSIGNED_BYTE:
+        return sizeof(GLubyte);
+    case GL_UNSIGNED_SHORT:
+        return sizeof(GLushort);
+    case GL_UNSIGNED_INT:
+        return sizeof(GLuint);
+    default:
+        throw std::invalid_argument("Invalid index type");
+    }
+}
+
+GLuint
+primitiveRestartIndex(const GLenum type)
+{
+    switch (type) {
+    case GL_UNSIGNED_BYTE:
+        return UINT8_MAX;
+    case GL_UNSIGNED_SHORT:
+        return UINT16_MAX;
+    default:
+        return UINT32_MAX;
+    }
+}
+
+std::vector<std::byte>
+packIndices(const std::span<const GLuint> indices, const GLenum type)
+{
+    std::vector<std::byte> data(indices.size() * indexTypeSize(type));
+    switch (type) {
+    case GL_UNSIGNED_BYTE:
+        packAs<GLubyte>(indices, data.data());
+        break;
+    case GL_UNSIGNED_SHORT:
+        packAs<GLushort>(indices, data.data());
+        break;
+    default:
+        packAs<GLuint>(indices, data.data());
+        break;
+    }
+    return data;
+}
+
+std::vector<GLuint>
+stripify(const std::span<const GLuint> indices)
+{
+    const std::size_t triangleCount = indices.size() / 3;
+    const EdgeIndex edges{indices};
+    std::vector<bool> emitted(triangleCount, false);
+
+    std::vector<GLuint> strips;
+    strips.reserve(indices.size());
+    for (std::size_t start = 0; start < triangleCount; ++start) {
+        if (emitted[start]) {
+            continue;
+        }
+        emitted[start] = true;
+
+        // Rotate starting triangle so that strip can continue over its last edge
+        const GLuint* v = &indices[start * 3];
+        std::size_t rotation{};
+        for (std::size_t r = 0; r < 3; ++r) {
+            const GLuint b = v[(r + 1) % 3];
+            const GLuint c = v[(r + 2) % 3];
+            if (edges.find(c, b, emitted) != kNoTriangle) {
+                rotation = r;
+                break;
+            }
+        }
+
+        if (not strips.empty()) {
+            strips.push_back(kPrimitiveRestartIndex);
+        }
+        GLuint p = v[(rotation + 1) % 3];
+        GLuint q = v[(rotation + 2) % 3];
+        strips.push_back(v[rotation]);
+        strips.push_back(p);
+        strips.push_back(q);
+
+        // Strip triangle k has winding (v[k], v[k+1], v[k+2]) for even and
+        // (v[k+1], v[k], v[k+2]) for odd k
+        for (std::size_t k = 1;; ++k) {
+            const bool odd = (k % 2) == 1;
+            const std::size_t next = odd ? edges.find(q, p, emitted) : edges.find(p, q, emitted);
+            if (next == kNoTriangle) {
+                break;
+            }
+            emitted[next] = true;
+            const GLuint x = thirdVertex(&indices[next * 3], p, q);
+            strips.push_back(x);
+            p = q;
+            q = x;
+        }
+    }
+    return strips;
+}
+
+} // namespace glesy
@@ -0,0 +1,357 @@
+#include "Json.hpp"
+
+#include <charconv>
+#include <cmath>
+#include <stdexcept>
+
+namespace glesy {
+
+namespace {
+
+const JsonValue kNull{};
+const std::string kEmptyString{};
+const std::vector<JsonValue> kEmptyItems{};
+
+constexpr std::size_t kMaxDepth{256};
+
+} // namespace
+
+class JsonParser {
+public:
+    explicit JsonParser(const std::string_view text)
+        : _text{text}
+    {
+    }
+
+    JsonValue
+    parseDocument()
+    {
+        JsonValue value = parseValue(0);
+        skipSpaces();
+        if (_pos != _text.size()) {
+            fail("Unexpected trailing characters");
+        }
+        return value;
+    }
+
+private:
+    [[noreturn]] void
+    fail(const char* message) const
+    {
+        throw std::runtime_error{std::string{"JSON: "} + message + " at offset "
+                                 + std::to_string(_pos)};
+    }
+
+    void
+    skipSpaces()
+    {
+        while (_pos < _text.size()
+               and (_text[_pos] == ' ' or _text[_pos] == '\t' or _text[_pos] == '\n'
+                    or _text[_pos] == '\r')) {
+            ++_pos;
+        }
+    }
+
+    char
+    peek()
+    {
+        skipSpaces();
+        if (_pos >= _text.size()) {
+            fail("Unexpected end of document");
+        }
+        return _text[_pos];
+    }
+
+    void
+    expect(const char ch)
+    {
+        if (peek() != ch) {
+            fail("Unexpected character");
+        }
+        ++_pos;
+    }
+
+    bool
+    consumeLiteral(const std::string_view literal)
+    {
+        if (_text.substr(_pos, literal.size()) == literal) {
+            _pos += literal.size();
+            return true;
+        }
+        return false;
+    }
+
+    JsonValue
+    parseValue(const std::size_t depth)
+    {
+        if (depth > kMaxDepth) {
+            fail("Document is nested too deep");
+        }
+
+        JsonValue value;
+        switch (peek()) {
+        case '{':
+            value._type = JsonValue::Type::Object;
+            ++_pos;
+            if (peek() == '}') {
+                ++_pos;
+                break;
+            }
+            while (true) {
+                if (peek() != '"') {
+                    fail("Expected object key");
+                }
+                std::string key = parseString();
+                expect(':');
+                value._members.emplace_back(std::move(key), parseValue(depth + 1));
+                if (peek() == ',') {
+                    ++_pos;
+                    continue;
+                }
+                expect('}');
+                break;
+            }
+            break;
+        case '[':
+            value._type = JsonValue::Type::Array;
+            ++_pos;
+            if (peek() == ']') {
+                ++_pos;
+                break;
+            }
+            while (true) {
+                value._items.push_back(parseValue(depth + 1));
+                if (peek() == ',') {
+                    ++_pos;
+                    continue;
+                }
+                expect(']');
+                break;
+            }
+            break;
+        case '"':
+            value._type = JsonValue::Type::String;
+            value._string = parseString();
+            break;
+        case 't':
+        case 'f':
+            value._type = JsonValue::Type::Bool;
+            if (consumeLiteral("true")) {
+                value._bool = true;
+            } else if (not consumeLiteral("false")) {
+                fail("Invalid literal");
+            }
+            break;
+        case 'n':
+            if (not consumeLiteral("null")) {
+                fail("Invalid literal");
+            }
+            break;
+        default:
+            value._type = JsonValue::Type::Number;
+            value._number = parseNumber();
+            break;
+        }
+        return value;
+    }
+
+    double
+    parseNumber()
+    {
+        const char* begin = _text.data() + _pos;
+        const char* end = _text.data() + _text.size();
+        double number{};
+        const auto [ptr, ec] = std::from_chars(begin, end, number);
+        if (ec != std::errc{} or ptr == begin) {
+            fail("Invalid number");
+        }
+        _pos += static_cast<std::size_t>(ptr - begin);
+        return number;
+    }
+
+    unsigned
+    parseHex4()
+    {
+        if (_pos + 4 > _text.size()) {
+            fail("Invalid unicode escape");
+        }
+        unsigned code{};
+        const char* begin = _text.data() + _pos;
+        const auto [ptr, ec] = std::from_chars(begin, begin + 4, code, 16);
+        if (ec != std::errc{} or ptr != begin + 4) {
+            fail("Invalid unicode escape");
+        }
+        _pos += 4;
+        return code;
+    }
+
+    static void
+    appendUtf8(std::string& out, const unsigned code)
+    {
+        if (code < 0x80) {
+            out.push_back(static_cast<char>(code));
+        } else if (code < 0x800) {
+            out.push_back(static_cast<char>(0xC0 | (code >> 6)));
+            out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        } else if (code < 0x10000) {
+            out.push_back(static_cast<char>(0xE0 | (code >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        } else {
+            out.push_back(static_cast<char>(0xF0 | (code >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        }
+    }
+
+    std::string
+    parseString()
+    {
+        expect('"');
+        std::string out;
+        while (true) {
+            if (_pos >= _text.size()) {
+                fail("Unterminated string");
+            }
+            const char ch = _text[_pos++];
+            if (ch == '"') {
+                return out;
+            }
+            if (ch != '\\') {
+                out.push_back(ch);
+                continue;
+            }
+            if (_pos >= _text.size()) {
+                fail("Unterminated string");
+            }
+            switch (const char escape = _text[_pos++]) {
+            case '"':
+            case '\\':
+            case '/':
+                out.push_back(escape);
+                break;
+            case 'b':
+                out.push_back('\b');
+                break;
+            case 'f':
+                out.push_back('\f');
+                break;
+            case 'n':
+                out.push_back('\n');
+                break;
+            case 'r':
+                out.push_back('\r');
+                break;
+            case 't':
+                out.push_back('\t');
+                break;
+            case 'u': {
+                unsigned code = parseHex4();
+                if (code >= 0xD800 and code < 0xDC00 and consumeLiteral("\\u")) {
+                    const unsigned low = parseHex4();
+                    code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                }
+                appendUtf8(out, code);
+                break;
+            }
+            default:
+                fail("Invalid escape sequence");
+            }
+        }
+    }
+
+private:
+    std::string_view _text;
+    std::size_t _pos{};
+};
+
+JsonValue
+JsonValue::parse(const std::string_view text)
+{
+    return JsonParser{text}.parseDocument();
+}
+
+JsonValue::Type
+JsonValue::type() const
+{
+    return _type;
+}
+
+bool
+JsonValue::isNull() const
+{
+    return _type == Type::Null;
+}
+
+bool
+JsonValue::asBool(const bool fallback) const
+{
+    return (_type == Type::Bool) ? _bool : fallback;
+}
+
+double
+JsonValue::asNumber(const double fallback) const
+{
+    return (_type == Type::Number) ? _number : fallback;
+}
+
+std::size_t
+JsonValue::asIndex(const std::size_t fallback) const
+{
+    if (_type != Type::Number or _number < 0.0 or std::floor(_number) != _number) {
+        return fallback;
+    }
+    return static_cast<std::size_t>(_number);
+}
+
+const std::string&
+JsonValue::asString() const
+{
+    return (_type == Type::String) ? _string : kEmptyString;
+}
+
+const std::vector<JsonValue>&
+JsonValue::items() const
+{
+    return (_type == Type::Array) ? _items : kEmptyItems;
+}
+
+std::size_t
+JsonValue::size() const
+{
+    switch (_type) {
+    case Type::Array:
+        return _items.size();
+    case Type::Object:
+        return _members.size();
+    default:
+        return 0;
+    }
+}
+
+const JsonValue*
+JsonValue::find(const std::string_view key) const
+{
+    for (const auto& [name, value] : _members) {
+        if (name == key) {
+            return &value;
+        }
+    }
+    return nullptr;
+}
+
+const JsonValue&
+JsonValue::operator[](const std::string_view key) const
+{
+    const auto* value = find(key);
+    return (value != nullptr) ? *value : kNull;
+}
+
+const JsonValue&
+JsonValue::operator[](const std::size_t index) const
+{
+    return (_type == Type::Array and index < _items.size()) ? _items[index] : kNull;
+}
+
+} // namespace glesy
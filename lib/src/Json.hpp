@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace glesy {
+
+/**
+ * Minimal DOM-style JSON reader (used by asset loaders)
+ */
+class JsonValue {
+public:
+    enum class Type { Null, Bool, Number, String, Array, Object };
+
+    /**
+     * Parse JSON document
+     * @param text The document text
+     * @return The root value
+     * @throw std::runtime_error if document is malformed
+     */
+    static JsonValue
+    parse(std::string_view text);
+
+    [[nodiscard]] Type
+    type() const;
+
+    [[nodiscard]] bool
+    isNull() const;
+
+    [[nodiscard]] bool
+    asBool(bool fallback = false) const;
+
+    [[nodiscard]] double
+    asNumber(double fallback = 0.0) const;
+
+    [[nodiscard]] std::size_t
+    asIndex(std::size_t fallback = 0) const;
+
+    [[nodiscard]] const std::string&
+    asString() const;
+
+    [[nodiscard]] const std::vector<JsonValue>&
+    items() const;
+
+    [[nodiscard]] std::size_t
+    size() const;
+
+    /**
+     * Get object member
+     * @return The member value or @c nullptr if value is not an object or has no such member
+     */
+    [[nodiscard]] const JsonValue*
+    find(std::string_view key) const;
+
+    /**
+     * Get object member (null value if missing)
+     */
+    [[nodiscard]] const JsonValue&
+    operator[](std::string_view key) const;
+
+    /**
+     * Get array item (null value if out of range)
+     */
+    [[nodiscard]] const JsonValue&
+    operator[](std::size_t index) const;
+
+private:
+    friend class JsonParser;
+
+    Type _type{Type::Null};
+    bool _bool{};
+    double _number{};
+    std::string _string;
+    std::vector<JsonValue> _items;
+    std::vector<std::pair<std::string, JsonValue>> _members;
+};
+
+} // namespace glesy
@@ -0,0 +1,634 @@
+#include "glesy/LightCuller.hpp"
+#include "glesy/Parallel.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) and defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace glesy {
+
+namespace {
+
+constexpr auto kShaderSource = R"glsl(
+uniform samplerBuffer uLights;
+uniform usamplerBuffer uLightTiles;
+uniform int uLightTileSize;
+uniform int uLightTilesX;
+
+struct PointLight {
+    vec3 position;
+    float radius;
+    vec3 color;
+    float intensity;
+};
+
+int lightTile()
+{
+    ivec2 tile = ivec2(gl_FragCoord.xy) / uLightTileSize;
+    return tile.y * uLightTilesX + tile.x;
+}
+
+int lightTileCount(int tile)
+{
+    return int(texelFetch(uLightTiles, tile * 2 + 1).r);
+}
+
+PointLight lightTileLight(int tile, int index)
+{
+    int offset = int(texelFetch(uLightTiles, tile * 2).r);
+    int light = int(texelFetch(uLightTiles, offset + index).r) * 2;
+    vec4 positionRadius = texelFetch(uLights, light);
+    vec4 colorIntensity = texelFetch(uLights, light + 1);
+    return PointLight(positionRadius.xyz, positionRadius.w, colorIntensity.rgb, colorIntensity.a);
+}
+)glsl";
+
+// Padding lights have negative infinite radius, so they are never visible
+constexpr float kPaddingRadius{-std::numeric_limits<float>::infinity()};
+
+// Lanes of the projection kernel, the scalar fallback processes one light at a time
+#if defined(__SSE2__)
+using Lanes = __m128;
+using Mask = __m128;
+
+Lanes
+splat(const float value)
+{
+    return _mm_set1_ps(value);
+}
+
+Lanes
+load(const float* data)
+{
+    return _mm_loadu_ps(data);
+}
+
+Lanes
+add(const Lanes a, const Lanes b)
+{
+    return _mm_add_ps(a, b);
+}
+
+Lanes
+sub(const Lanes a, const Lanes b)
+{
+    return _mm_sub_ps(a, b);
+}
+
+Lanes
+mul(const Lanes a, const Lanes b)
+{
+    return _mm_mul_ps(a, b);
+}
+
+Lanes
+div(const Lanes a, const Lanes b)
+{
+    return _mm_div_ps(a, b);
+}
+
+Lanes
+min(const Lanes a, const Lanes b)
+{
+    return _mm_min_ps(a, b);
+}
+
+Lanes
+max(const Lanes a, const Lanes b)
+{
+    return _mm_max_ps(a, b);
+}
+
+Mask
+less(const Lanes a, const Lanes b)
+{
+    return _mm_cmplt_ps(a, b);
+}
+
+Mask
+both(const Mask a, const Mask b)
+{
+    return _mm_and_ps(a, b);
+}
+
+Lanes
+select(const Mask mask, const Lanes a, const Lanes b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+unsigned
+bits(const Mask mask)
+{
+    return static_cast<unsigned>(_mm_movemask_ps(mask));
+}
+
+void
+store(const Lanes value, std::int32_t* output)
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm_cvttps_epi32(value));
+}
+#elif defined(__ARM_NEON) and defined(__aarch64__)
+using Lanes = float32x4_t;
+using Mask = uint32x4_t;
+
+Lanes
+splat(const float value)
+{
+    return vdupq_n_f32(value);
+}
+
+Lanes
+load(const float* data)
+{
+    return vld1q_f32(data);
+}
+
+Lanes
+add(const Lanes a, const Lanes b)
+{
+    return vaddq_f32(a, b);
+}
+
+Lanes
+sub(const Lanes a, const Lanes b)
+{
+    return vsubq_f32(a, b);
+}
+
+Lanes
+mul(const Lanes a, const Lanes b)
+{
+    return vmulq_f32(a, b);
+}
+
+Lanes
+div(const Lanes a, const Lanes b)
+{
+    return vdivq_f32(a, b);
+}
+
+Lanes
+min(const Lanes a, const Lanes b)
+{
+    return vminq_f32(a, b);
+}
+
+Lanes
+max(const Lanes a, const Lanes b)
+{
+    return vmaxq_f32(a, b);
+}
+
+Mask
+less(const Lanes a, const Lanes b)
+{
+    return vcltq_f32(a, b);
+}
+
+Mask
+both(const Mask a, const Mask b)
+{
+    return vandq_u32(a, b);
+}
+
+Lanes
+select(const Mask mask, const Lanes a, const Lanes b)
+{
+    return vbslq_f32(mask, a, b);
+}
+
+unsigned
+bits(const Mask mask)
+{
+    static const int32x4_t kShifts{0, 1, 2, 3};
+    return vaddvq_u32(vshlq_u32(vshrq_n_u32(mask, 31), kShifts));
+}
+
+void
+store(const Lanes value, std::int32_t* output)
+{
+    vst1q_s32(output, vcvtq_s32_f32(value));
+}
+#else
+using Lanes = float;
+using Mask = bool;
+
+Lanes
+splat(const float value)
+{
+    return value;
+}
+
+Lanes
+load(const float* data)
+{
+    return *data;
+}
+
+Lanes
+add(const Lanes a, const Lanes b)
+{
+    return a + b;
+}
+
+Lanes
+sub(const Lanes a, const Lanes b)
+{
+    return a - b;
+}
+
+Lanes
+mul(const Lanes a, const Lanes b)
+{
+    return a * b;
+}
+
+Lanes
+div(const Lanes a, const Lanes b)
+{
+    return a / b;
+}
+
+Lanes
+min(const Lanes a, const Lanes b)
+{
+    return std::min(a, b);
+}
+
+Lanes
+max(const Lanes a, const Lanes b)
+{
+    return std::max(a, b);
+}
+
+Mask
+less(const Lanes a, const Lanes b)
+{
+    return a < b;
+}
+
+Mask
+both(const Mask a, const Mask b)
+{
+    return a and b;
+}
+
+Lanes
+select(const Mask mask, const Lanes a, const Lanes b)
+{
+    return mask ? a : b;
+}
+
+unsigned
+bits(const Mask mask)
+{
+    return mask ? 1 : 0;
+}
+
+void
+store(const Lanes value, std::int32_t* output)
+{
+    *output = static_cast<std::int32_t>(value);
+}
+#endif
+
+constexpr std::size_t kLanes{sizeof(Lanes) / sizeof(float)};
+
+/**
+ * Projection of view space sphere bounds to tile coordinates along one screen axis.
+ * Sphere is bounded by the box, and the extremes of x / depth over the box are taken at the
+ * nearest or farthest depth depending on the sign of x.
+ */
+struct Axis {
+    Lanes scale;  // projection matrix diagonal element
+    Lanes offset; // projection matrix skew (off-center frustum)
+    Lanes tiles;  // half viewport size in tiles
+    Lanes last;   // index of the last tile
+};
+
+void
+project(const Axis& axis,
+        const Lanes center,
+        const Lanes radius,
+        const Lanes nearest,
+        const Lanes farthest,
+        const Mask crossing,
+        Mask& visible,
+        std::int32_t* minimum,
+        std::int32_t* maximum)
+{
+    const Lanes zero = splat(0.0f);
+    const Lanes one = splat(1.0f);
+    const Lanes lower = sub(center, radius);
+    const Lanes upper = add(center, radius);
+    Lanes low = div(lower, select(less(lower, zero), nearest, farthest));
+    Lanes high = div(upper, select(less(zero, upper), nearest, farthest));
+    // Clip space x = P00 * x + P20 * z with w = -z
+    low = sub(mul(axis.scale, low), axis.offset);
+    high = sub(mul(axis.scale, high), axis.offset);
+    // Spheres crossing the near plane may cover any part of the screen
+    low = select(crossing, splat(-1.0f), low);
+    high = select(crossing, one, high);
+    visible = both(visible, both(less(low, one), less(splat(-1.0f), high)));
+
+    low = min(max(mul(add(low, one), axis.tiles), zero), axis.last);
+    high = min(max(mul(add(high, one), axis.tiles), zero), axis.last);
+    store(low, minimum);
+    store(high, maximum);
+}
+
+} // namespace
+
+LightCuller::LightCuller(const GLsizei width, const GLsizei height, const GLsizei tileSize)
+    : _tileSize{tileSize}
+{
+    if (tileSize <= 0) {
+        throw std::invalid_argument{"Light tile size must be positive"};
+    }
+    resize(width, height);
+}
+
+LightCuller::~LightCuller()
+{
+    if (_lightTexture != 0) {
+        glDeleteTextures(1, &_lightTexture);
+    }
+    if (_tileTexture != 0) {
+        glDeleteTextures(1, &_tileTexture);
+    }
+}
+
+void
+LightCuller::resize(const GLsizei width, const GLsizei height)
+{
+    _width = std::max<GLsizei>(width, 1);
+    _height = std::max<GLsizei>(height, 1);
+    _tilesX = (_width + _tileSize - 1) / _tileSize;
+    _tilesY = (_height + _tileSize - 1) / _tileSize;
+    _counts.assign(static_cast<std::size_t>(_tilesX) * _tilesY, 0);
+    _tiles.assign(_counts.size() * 2, 0);
+    _visibleLights.clear();
+    _lightData.clear();
+    _stats = {};
+}
+
+void
+LightCuller::cull(const std::span<const PointLight> lights,
+                  const glm::mat4& view,
+                  const glm::mat4& projection,
+                  const std::size_t grain)
+{
+    const std::size_t padded = (lights.size() + kLanes - 1) / kLanes * kLanes;
+    _x.resize(padded);
+    _y.resize(padded);
+    _z.resize(padded);
+    _radius.resize(padded);
+    for (std::size_t index = 0; index < lights.size(); ++index) {
+        const glm::vec3& position = lights[index].position;
+        _x[index] = view[0][0] * position.x + view[1][0] * position.y + view[2][0] * position.z
+                    + view[3][0];
+        _y[index] = view[0][1] * position.x + view[1][1] * position.y + view[2][1] * position.z
+                    + view[3][1];
+        // Depth is the distance in front of the camera (view space looks along -z)
+        _z[index] = -(view[0][2] * position.x + view[1][2] * position.y
+                      + view[2][2] * position.z + view[3][2]);
+        _radius[index] = lights[index].radius;
+    }
+    std::fill(_x.begin() + lights.size(), _x.end(), 0.0f);
+    std::fill(_y.begin() + lights.size(), _y.end(), 0.0f);
+    std::fill(_z.begin() + lights.size(), _z.end(), 1.0f);
+    std::fill(_radius.begin() + lights.size(), _radius.end(), kPaddingRadius);
+    _minX.resize(padded);
+    _maxX.resize(padded);
+    _minY.resize(padded);
+    _maxY.resize(padded);
+    _visible.resize(padded);
+
+    // Near and far distances of the OpenGL perspective projection. Infinite projection has
+    // P22 = -1 (or slightly above to fight precision loss), that gives a zero denominator or
+    // a far distance behind the near one.
+    const float near = projection[3][2] / (projection[2][2] - 1.0f);
+    float far = projection[3][2] / (projection[2][2] + 1.0f);
+    if (not(far > near)) {
+        far = std::numeric_limits<float>::infinity();
+    }
+    const Axis axisX{splat(projection[0][0]),
+                     splat(projection[2][0]),
+                     splat(static_cast<float>(_width) * 0.5f / static_cast<float>(_tileSize)),
+                     splat(static_cast<float>(_tilesX - 1))};
+    const Axis axisY{splat(projection[1][1]),
+                     splat(projection[2][1]),
+                     splat(static_cast<float>(_height) * 0.5f / static_cast<float>(_tileSize)),
+                     splat(static_cast<float>(_tilesY - 1))};
+
+    const std::size_t blocks = padded / kLanes;
+    parallelFor(blocks,
+                std::max<std::size_t>(grain / kLanes, 1),
+                [&](const std::size_t begin, const std::size_t end) {
+                    const Lanes nearPlane = splat(near);
+                    const Lanes farPlane = splat(far);
+                    for (std::size_t block = begin; block < end; ++block) {
+                        const std::size_t base = block * kLanes;
+                        const Lanes x = load(_x.data() + base);
+                        const Lanes y = load(_y.data() + base);
+                        const Lanes depth = load(_z.data() + base);
+                        const Lanes radius = load(_radius.data() + base);
+                        const Lanes nearest = sub(depth, radius);
+                        const Lanes farthest = add(depth, radius);
+                        Mask visible = both(less(nearPlane, farthest), less(nearest, farPlane));
+                        const Mask crossing = less(nearest, nearPlane);
+                        const Lanes clamped = max(nearest, nearPlane);
+                        project(axisX,
+                                x,
+                                radius,
+                                clamped,
+                                farthest,
+                                crossing,
+                                visible,
+                                _minX.data() + base,
+                                _maxX.data() + base);
+                        project(axisY,
+                                y,
+                                radius,
+                                clamped,
+                                farthest,
+                                crossing,
+                                visible,
+                                _minY.data() + base,
+                                _maxY.data() + base);
+                        const unsigned mask = bits(visible);
+                        for (std::size_t lane = 0; lane < kLanes; ++lane) {
+                            _visible[base + lane] = (mask >> lane) & 1U;
+                        }
+                    }
+                });
+
+    _visibleLights.clear();
+    _lightData.clear();
+    for (std::size_t index = 0; index < lights.size(); ++index) {
+        if (_visible[index] == 0) {
+            continue;
+        }
+        const PointLight& light = lights[index];
+        // Keep rectangles of visible lights packed, so binning skips culled lights
+        const std::size_t packed = _visibleLights.size();
+        _minX[packed] = _minX[index];
+        _maxX[packed] = _maxX[index];
+        _minY[packed] = _minY[index];
+        _maxY[packed] = _maxY[index];
+        _visibleLights.push_back(static_cast<std::uint32_t>(index));
+        _lightData.insert(_lightData.end(),
+                          {light.position.x,
+                           light.position.y,
+                           light.position.z,
+                           light.radius,
+                           light.color.x,
+                           light.color.y,
+                           light.color.z,
+                           light.intensity});
+    }
+
+    // Tile rows are binned in parallel, each task owns its rows so no atomics are needed
+    const std::size_t visibleCount = _visibleLights.size();
+    const auto bin = [&](auto&& emit) {
+        parallelFor(static_cast<std::size_t>(_tilesY),
+                    4,
+                    [&](const std::size_t begin, const std::size_t end) {
+                        const auto first = static_cast<std::int32_t>(begin);
+                        const auto last = static_cast<std::int32_t>(end) - 1;
+                        for (std::size_t light = 0; light < visibleCount; ++light) {
+                            const std::int32_t minY = std::max(_minY[light], first);
+                            const std::int32_t maxY = std::min(_maxY[light], last);
+                            for (std::int32_t row = minY; row <= maxY; ++row) {
+                                const std::size_t tile = static_cast<std::size_t>(row) * _tilesX;
+                                for (std::int32_t x = _minX[light]; x <= _maxX[light]; ++x) {
+                                    emit(tile + x, static_cast<std::uint32_t>(light));
+                                }
+                            }
+                        }
+                    });
+    };
+
+    std::ranges::fill(_counts, 0);
+    bin([&](const std::size_t tile, std::uint32_t) { _counts[tile]++; });
+
+    std::size_t offset = _counts.size() * 2;
+    std::size_t maxPerTile{};
+    for (std::size_t tile = 0; tile < _counts.size(); ++tile) {
+        const std::uint32_t count = _counts[tile];
+        _tiles[tile * 2] = static_cast<std::uint32_t>(offset);
+        _tiles[tile * 2 + 1] = count;
+        // Counts become write cursors of the second binning pass
+        _counts[tile] = static_cast<std::uint32_t>(offset);
+        offset += count;
+        maxPerTile = std::max<std::size_t>(maxPerTile, count);
+    }
+    _tiles.resize(offset);
+    bin([&](const std::size_t tile, const std::uint32_t light) {
+        _tiles[_counts[tile]++] = light;
+    });
+
+    _stats.lights = lights.size();
+    _stats.visible = visibleCount;
+    _stats.references = offset - _counts.size() * 2;
+    _stats.maxPerTile = maxPerTile;
+}
+
+void
+LightCuller::upload()
+{
+    if (not _lightBuffer) {
+        _lightBuffer.emplace(GL_TEXTURE_BUFFER);
+        _tileBuffer.emplace(GL_TEXTURE_BUFFER);
+        glGenTextures(1, &_lightTexture);
+        glGenTextures(1, &_tileTexture);
+    }
+
+    // Keep buffers non-empty, texture buffers without storage are incomplete
+    static constexpr std::array<float, 8> kNoLight{};
+    if (_lightData.empty()) {
+        _lightBuffer->setData(sizeof(kNoLight), kNoLight.data(), GL_STREAM_DRAW);
+    } else {
+        _lightBuffer->setData(static_cast<GLsizeiptr>(_lightData.size() * sizeof(float)),
+                              _lightData.data(),
+                              GL_STREAM_DRAW);
+    }
+    _tileBuffer->setData(static_cast<GLsizeiptr>(_tiles.size() * sizeof(std::uint32_t)),
+                         _tiles.data(),
+                         GL_STREAM_DRAW);
+
+    // Buffer storage is reallocated by setData, reattach it
+    glBindTexture(GL_TEXTURE_BUFFER, _lightTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, _lightBuffer->id());
+    glBindTexture(GL_TEXTURE_BUFFER, _tileTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_R32UI, _tileBuffer->id());
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+}
+
+void
+LightCuller::bind(const Shader& shader, const GLuint lightUnit, const GLuint tileUnit) const
+{
+    glActiveTexture(GL_TEXTURE0 + lightUnit);
+    glBindTexture(GL_TEXTURE_BUFFER, _lightTexture);
+    glActiveTexture(GL_TEXTURE0 + tileUnit);
+    glBindTexture(GL_TEXTURE_BUFFER, _tileTexture);
+    glActiveTexture(GL_TEXTURE0);
+
+    shader.setInt("uLights", static_cast<int>(lightUnit));
+    shader.setInt("uLightTiles", static_cast<int>(tileUnit));
+    shader.setInt("uLightTileSize", _tileSize);
+    shader.setInt("uLightTilesX", _tilesX);
+}
+
+const char*
+LightCuller::shaderSource()
+{
+    return kShaderSource;
+}
+
+GLsizei
+LightCuller::tileSize() const
+{
+    return _tileSize;
+}
+
+GLsizei
+LightCuller::tilesX() const
+{
+    return _tilesX;
+}
+
+GLsizei
+LightCuller::tilesY() const
+{
+    return _tilesY;
+}
+
+std::span<const std::uint32_t>
+LightCuller::tiles() const
+{
+    return _tiles;
+}
+
+std::span<const std::uint32_t>
+LightCuller::visibleLights() const
+{
+    return _visibleLights;
+}
+
+const LightCuller::Stats&
+LightCuller::stats() const
+{
+    return _stats;
+}
+
+} // namespace glesy
@@ -0,0 +1,90 @@
+#include "glesy/MappedFile.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <stdexcept>
+#include <utility>
+
+namespace glesy {
+
+MappedFile::MappedFile(const std::filesystem::path& filePath)
+{
+    const int fd = ::open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error{"Unable to open file"};
+    }
+
+    struct stat info{};
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw std::runtime_error{"Unable to get file size"};
+    }
+
+    _size = static_cast<std::size_t>(info.st_size);
+    if (_size > 0) {
+        void* data = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error{"Unable to map file"};
+        }
+        // Loaders touch the whole content right away (from several threads)
+        ::madvise(data, _size, MADV_WILLNEED);
+        _data = static_cast<const std::byte*>(data);
+    }
+    ::close(fd);
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : _data{std::exchange(other._data, nullptr)}
+    , _size{std::exchange(other._size, 0)}
+{
+}
+
+MappedFile&
+MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other) {
+        release();
+        _data = std::exchange(other._data, nullptr);
+        _size = std::exchange(other._size, 0);
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile()
+{
+    release();
+}
+
+std::span<const std::byte>
+MappedFile::bytes() const
+{
+    return {_data, _size};
+}
+
+std::string_view
+MappedFile::text() const
+{
+    return {reinterpret_cast<const char*>(_data), _size};
+}
+
+std::size_t
+MappedFile::size() const
+{
+    return _size;
+}
+
+void
+MappedFile::release()
+{
+    if (_data != nullptr) {
+        ::munmap(const_cast<std::byte*>(_data), _size);
+        _data = nullptr;
+        _size = 0;
+    }
+}
+
+} // namespace glesy
@@ -0,0 +1,190 @@
+#include "glesy/Mesh.hpp"
+
+#include "glesy/Indices.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace glesy {
+
+Mesh::Mesh(const void* vertices,
+           const GLsizeiptr verticesSize,
+           const VertexFormat& format,
+           const std::span<const GLuint> indices,
+           const GLenum primitive)
+    : _vertices{GL_ARRAY_BUFFER, verticesSize, vertices}
+    , _indices{GL_ELEMENT_ARRAY_BUFFER}
+    , _format{format}
+    , _indexCount{static_cast<GLsizei>(indices.size())}
+    , _primitive{primitive}
+{
+    GLuint maxIndex{};
+    for (const GLuint index : indices) {
+        if (index == kPrimitiveRestartIndex) {
+            _primitiveRestart = true;
+        } else {
+            maxIndex = std::max(maxIndex, index);
+        }
+    }
+    _indexType = selectIndexType(std::size_t{maxIndex} + 1, _primitiveRestart);
+    setIndices(packIndices(indices, _indexType).data());
+}
+
+Mesh::Mesh(const void* vertices,
+           const GLsizeiptr verticesSize,
+           const VertexFormat& format,
+           const void* indices,
+           const GLsizei indexCount,
+           const GLenum indexType,
+           const GLenum primitive,
+           const bool primitiveRestart)
+    : _vertices{GL_ARRAY_BUFFER, verticesSize, vertices}
+    , _indices{GL_ELEMENT_ARRAY_BUFFER}
+    , _format{format}
+    , _indexCount{indexCount}
+    , _indexType{indexType}
+    , _primitive{primitive}
+    , _primitiveRestart{primitiveRestart}
+{
+    setIndices(indices);
+}
+
+const VertexArray&
+Mesh::vertexArray() const
+{
+    return _vertexArray;
+}
+
+const Buffer&
+Mesh::vertexBuffer() const
+{
+    return _vertices;
+}
+
+const Buffer&
+Mesh::indexBuffer() const
+{
+    return _indices;
+}
+
+const VertexFormat&
+Mesh::format() const
+{
+    return _format;
+}
+
+GLsizei
+Mesh::indexCount() const
+{
+    return _indexCount;
+}
+
+GLenum
+Mesh::indexType() const
+{
+    return _indexType;
+}
+
+GLenum
+Mesh::primitive() const
+{
+    return _primitive;
+}
+
+bool
+Mesh::primitiveRestart() const
+{
+    return _primitiveRestart;
+}
+
+void
+Mesh::setLods(std::vector<MeshLod> lods)
+{
+    const bool inRange = std::ranges::all_of(lods, [this](const MeshLod& lod) {
+        return lod.firstIndex + lod.indexCount <= static_cast<GLuint>(_indexCount);
+    });
+    if (lods.empty() or not inRange) {
+        throw std::invalid_argument("Levels of detail are out of index buffer range");
+    }
+    _lods = std::move(lods);
+}
+
+const std::vector<MeshLod>&
+Mesh::lods() const
+{
+    return _lods;
+}
+
+void
+Mesh::attachInstances(const Buffer& buffer, const VertexFormat& format)
+{
+    const bool perInstance = std::ranges::all_of(
+        format.attributes, [](const VertexAttribute& attr) { return attr.divisor > 0; });
+    if (not perInstance) {
+        throw std::invalid_argument("Instance format requires non-zero attribute divisors");
+    }
+    _vertexArray.setVertexBuffer(buffer, format);
+}
+
+void
+Mesh::draw(const std::size_t lod) const
+{
+    const auto& level = _lods.at(lod);
+    beginDraw();
+    glDrawElements(
+        _primitive, static_cast<GLsizei>(level.indexCount), _indexType, lodOffset(level));
+    endDraw();
+}
+
+void
+Mesh::drawInstanced(const GLsizei instanceCount, const std::size_t lod) const
+{
+    if (instanceCount <= 0) {
+        return;
+    }
+    const auto& level = _lods.at(lod);
+    beginDraw();
+    glDrawElementsInstanced(_primitive,
+                            static_cast<GLsizei>(level.indexCount),
+                            _indexType,
+                            lodOffset(level),
+                            instanceCount);
+    endDraw();
+}
+
+void
+Mesh::setIndices(const void* indices)
+{
+    _lods.assign(1, MeshLod{.indexCount = static_cast<GLuint>(_indexCount)});
+    _vertexArray.setVertexBuffer(_vertices, _format);
+    _indices.setData(
+        static_cast<GLsizeiptr>(static_cast<std::size_t>(_indexCount) * indexTypeSize(_indexType)),
+        indices);
+    _vertexArray.setIndexBuffer(_indices);
+}
+
+const void*
+Mesh::lodOffset(const MeshLod& lod) const
+{
+    return reinterpret_cast<const void*>(lod.firstIndex * indexTypeSize(_indexType));
+}
+
+void
+Mesh::beginDraw() const
+{
+    _vertexArray.bind();
+    if (_primitiveRestart) {
+        glEnable(GL_PRIMITIVE_RESTART);
+        glPrimitiveRestartIndex(primitiveRestartIndex(_indexType));
+    }
+}
+
+void
+Mesh::endDraw() const
+{
+    if (_primitiveRestart) {
+        glDisable(GL_PRIMITIVE_RESTART);
+    }
+}
+
+} // namespace glesy
@@ -0,0 +1,442 @@
+#include "glesy/MeshCache.hpp"
+
+#include "glesy/AssetHash.hpp"
+#include "glesy/Indices.hpp"
+#include "glesy/MeshOptimizer.hpp"
+#include "glesy/VertexLayout.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace glesy {
+
+namespace {
+
+constexpr std::array<char, 4> kMagic{'G', 'M', 'S', 'H'};
+/** Blobs are aligned to cache line inside the file */
+constexpr std::uint64_t kBlobAlignment{64};
+
+struct Header {
+    std::array<char, 4> magic{};
+    std::uint32_t version{};
+    std::uint64_t sourceHash{};
+    std::uint64_t cookerHash{};
+    std::uint32_t vertexCount{};
+    std::uint32_t vertexStride{};
+    std::uint32_t indexCount{};
+    std::uint32_t indexType{};
+    std::uint32_t attributeCount{};
+    std::uint32_t lodCount{};
+    std::uint32_t fileCount{};
+    std::array<float, 3> boundsMin{};
+    std::array<float, 3> boundsMax{};
+    std::uint64_t attributesOffset{};
+    std::uint64_t lodsOffset{};
+    std::uint64_t filesOffset{};
+    std::uint64_t verticesOffset{};
+    std::uint64_t indicesOffset{};
+};
+
+struct AttributeRecord {
+    std::uint32_t location{};
+    std::int32_t components{};
+    std::uint32_t type{};
+    std::uint32_t normalized{};
+    std::uint32_t integer{};
+    std::int32_t offset{};
+    std::uint32_t divisor{};
+};
+
+struct LodRecord {
+    std::uint32_t firstIndex{};
+    std::uint32_t indexCount{};
+    float error{};
+};
+
+/**
+ * Source file stamp, the path is stored in the string blob following the records
+ */
+struct FileRecord {
+    std::uint64_t size{};
+    std::int64_t modified{};
+    std::uint64_t pathOffset{};
+    std::uint64_t pathLength{};
+};
+
+static_assert(std::is_trivially_copyable_v<Header>);
+static_assert(std::is_trivially_copyable_v<AttributeRecord>);
+static_assert(std::is_trivially_copyable_v<LodRecord>);
+static_assert(std::is_trivially_copyable_v<FileRecord>);
+
+std::uint64_t
+alignOffset(const std::uint64_t offset)
+{
+    return (offset + kBlobAlignment - 1) / kBlobAlignment * kBlobAlignment;
+}
+
+std::uint64_t
+cookerHash(const MeshCookOptions& options)
+{
+    std::uint64_t hash = hashValue(kMeshCacheVersion);
+    hash = hashValue(options.optimize, hash);
+    hash = hashValue(static_cast<std::uint64_t>(options.maxLods), hash);
+    return hashValue(options.lodReduction, hash);
+}
+
+template<typename T>
+T
+readRecord(const std::span<const std::byte> bytes, const std::uint64_t offset)
+{
+    if (offset > bytes.size() or bytes.size() - offset < sizeof(T)) {
+        throw std::runtime_error{"Cooked mesh is truncated"};
+    }
+    T record;
+    std::memcpy(&record, bytes.data() + offset, sizeof(T));
+    return record;
+}
+
+std::span<const std::byte>
+blob(const std::span<const std::byte> bytes, const std::uint64_t offset, const std::uint64_t size)
+{
+    if (offset > bytes.size() or bytes.size() - offset < size) {
+        throw std::runtime_error{"Cooked mesh is truncated"};
+    }
+    return bytes.subspan(offset, size);
+}
+
+bool
+validIndexType(const std::uint32_t type)
+{
+    return type == GL_UNSIGNED_BYTE or type == GL_UNSIGNED_SHORT or type == GL_UNSIGNED_INT;
+}
+
+/**
+ * Check that attribute fetch stays inside the vertex
+ */
+bool
+validAttribute(const AttributeRecord& record, const std::uint32_t stride)
+{
+    if (record.components < 1 or record.components > 4 or record.offset < 0) {
+        return false;
+    }
+    std::int64_t size = std::int64_t{detail::componentSize(record.type)} * record.components;
+    if (detail::isPackedType(record.type)) {
+        // All components share one 32-bit word
+        size = 4;
+    }
+    return size > 0 and record.offset + size <= std::int64_t{stride};
+}
+
+} // namespace
+
+void
+cookMesh(const MeshData& mesh,
+         const std::filesystem::path& cachePath,
+         const MeshSource& source)
+{
+    const auto format = MeshVertexLayout::format();
+    const GLenum indexType = selectIndexType(mesh.vertices.size());
+    const auto indices = packIndices(mesh.indices, indexType);
+    std::vector<MeshLod> lods = mesh.lods;
+    if (lods.empty()) {
+        lods.push_back(MeshLod{.indexCount = static_cast<GLuint>(mesh.indices.size())});
+    }
+
+    Header header{.magic = kMagic,
+                  .version = kMeshCacheVersion,
+                  .sourceHash = source.hash,
+                  .cookerHash = source.cookerHash,
+                  .vertexCount = static_cast<std::uint32_t>(mesh.vertices.size()),
+                  .vertexStride = static_cast<std::uint32_t>(format.stride),
+                  .indexCount = static_cast<std::uint32_t>(mesh.indices.size()),
+                  .indexType = indexType,
+                  .attributeCount = static_cast<std::uint32_t>(format.attributes.size()),
+                  .lodCount = static_cast<std::uint32_t>(lods.size()),
+                  .fileCount = static_cast<std::uint32_t>(source.files.size())};
+    header.boundsMin.fill(std::numeric_limits<float>::max());
+    header.boundsMax.fill(std::numeric_limits<float>::lowest());
+    for (const auto& vertex : mesh.vertices) {
+        for (int axis = 0; axis < 3; ++axis) {
+            header.boundsMin[axis] = std::min(header.boundsMin[axis], vertex.position[axis]);
+            header.boundsMax[axis] = std::max(header.boundsMax[axis], vertex.position[axis]);
+        }
+    }
+    header.attributesOffset = sizeof(Header);
+    header.lodsOffset = header.attributesOffset + header.attributeCount * sizeof(AttributeRecord);
+    header.filesOffset = header.lodsOffset + header.lodCount * sizeof(LodRecord);
+    std::vector<std::string> paths;
+    std::uint64_t pathsOffset = header.filesOffset + header.fileCount * sizeof(FileRecord);
+    for (const auto& file : source.files) {
+        paths.push_back(file.path.string());
+        pathsOffset += paths.back().size();
+    }
+    header.verticesOffset = alignOffset(pathsOffset);
+    header.indicesOffset
+        = alignOffset(header.verticesOffset + mesh.vertices.size() * sizeof(MeshVertex));
+
+    std::vector<std::byte> bytes(header.indicesOffset + indices.size());
+    std::memcpy(bytes.data(), &header, sizeof(Header));
+    auto* cursor = bytes.data() + header.attributesOffset;
+    for (const auto& attr : format.attributes) {
+        const AttributeRecord record{.location = attr.location,
+                                     .components = attr.components,
+                                     .type = attr.type,
+                                     .normalized = attr.normalized ? 1U : 0U,
+                                     .integer = attr.integer ? 1U : 0U,
+                                     .offset = attr.offset,
+                                     .divisor = attr.divisor};
+        std::memcpy(cursor, &record, sizeof(record));
+        cursor += sizeof(record);
+    }
+    for (const auto& lod : lods) {
+        const LodRecord record{
+            .firstIndex = lod.firstIndex, .indexCount = lod.indexCount, .error = lod.error};
+        std::memcpy(cursor, &record, sizeof(record));
+        cursor += sizeof(record);
+    }
+    std::uint64_t pathOffset = header.filesOffset + header.fileCount * sizeof(FileRecord);
+    for (std::size_t index = 0; index < source.files.size(); ++index) {
+        const FileRecord record{.size = source.files[index].size,
+                                .modified = source.files[index].modified,
+                                .pathOffset = pathOffset,
+                                .pathLength = paths[index].size()};
+        std::memcpy(cursor, &record, sizeof(record));
+        cursor += sizeof(record);
+        std::memcpy(bytes.data() + pathOffset, paths[index].data(), paths[index].size());
+        pathOffset += paths[index].size();
+    }
+    std::memcpy(bytes.data() + header.verticesOffset,
+                mesh.vertices.data(),
+                mesh.vertices.size() * sizeof(MeshVertex));
+    std::memcpy(bytes.data() + header.indicesOffset, indices.data(), indices.size());
+
+    // Readers never observe partially written file
+    auto tempPath = cachePath;
+    tempPath += ".tmp";
+    {
+        std::ofstream stream{tempPath, std::ios::binary | std::ios::trunc};
+        stream.write(reinterpret_cast<const char*>(bytes.data()),
+                     static_cast<std::streamsize>(bytes.size()));
+        if (not stream) {
+            throw std::runtime_error{"Unable to write cooked mesh"};
+        }
+    }
+    std::filesystem::rename(tempPath, cachePath);
+}
+
+CookedMesh::CookedMesh(const std::filesystem::path& cachePath)
+    : _file{cachePath}
+{
+    const auto bytes = _file.bytes();
+    const auto header = readRecord<Header>(bytes, 0);
+    if (header.magic != kMagic or header.version != kMeshCacheVersion) {
+        throw std::runtime_error{"Not a cooked mesh of current version"};
+    }
+
+    constexpr auto kMaxCount = static_cast<std::uint32_t>(std::numeric_limits<GLsizei>::max());
+    if (not validIndexType(header.indexType)) {
+        throw std::runtime_error{"Cooked mesh has invalid index type"};
+    }
+    if (header.vertexStride == 0 or header.vertexCount > kMaxCount
+        or header.indexCount > kMaxCount) {
+        throw std::runtime_error{"Cooked mesh has invalid vertex or index count"};
+    }
+    // Record tables must fit the file before any count is trusted
+    static_cast<void>(blob(bytes,
+                           header.attributesOffset,
+                           std::uint64_t{header.attributeCount} * sizeof(AttributeRecord)));
+    static_cast<void>(
+        blob(bytes, header.lodsOffset, std::uint64_t{header.lodCount} * sizeof(LodRecord)));
+    static_cast<void>(
+        blob(bytes, header.filesOffset, std::uint64_t{header.fileCount} * sizeof(FileRecord)));
+    if (header.lodCount == 0) {
+        throw std::runtime_error{"Cooked mesh has no levels of detail"};
+    }
+
+    _sourceHash = header.sourceHash;
+    _cookerHash = header.cookerHash;
+    _vertexCount = static_cast<GLsizei>(header.vertexCount);
+    _indexCount = static_cast<GLsizei>(header.indexCount);
+    _indexType = header.indexType;
+    _boundsMin = {header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]};
+    _boundsMax = {header.boundsMax[0], header.boundsMax[1], header.boundsMax[2]};
+
+    _format.stride = static_cast<GLsizei>(header.vertexStride);
+    for (std::uint32_t index = 0; index < header.attributeCount; ++index) {
+        const auto record = readRecord<AttributeRecord>(
+            bytes, header.attributesOffset + index * sizeof(AttributeRecord));
+        if (not validAttribute(record, header.vertexStride)) {
+            throw std::runtime_error{"Cooked mesh attribute is outside of vertex"};
+        }
+        _format.attributes.push_back(VertexAttribute{.location = record.location,
+                                                     .components = record.components,
+                                                     .type = record.type,
+                                                     .normalized = record.normalized != 0,
+                                                     .integer = record.integer != 0,
+                                                     .offset = record.offset,
+                                                     .divisor = record.divisor});
+    }
+    for (std::uint32_t index = 0; index < header.lodCount; ++index) {
+        const auto record
+            = readRecord<LodRecord>(bytes, header.lodsOffset + index * sizeof(LodRecord));
+        if (std::uint64_t{record.firstIndex} + record.indexCount > header.indexCount) {
+            throw std::runtime_error{"Cooked mesh LOD is outside of index data"};
+        }
+        _lods.push_back(MeshLod{.firstIndex = record.firstIndex,
+                                .indexCount = record.indexCount,
+                                .error = record.error});
+    }
+
+    for (std::uint32_t index = 0; index < header.fileCount; ++index) {
+        const auto record
+            = readRecord<FileRecord>(bytes, header.filesOffset + index * sizeof(FileRecord));
+        const auto path = blob(bytes, record.pathOffset, record.pathLength);
+        _sourceFiles.push_back(
+            FileStamp{.path = std::string{reinterpret_cast<const char*>(path.data()), path.size()},
+                      .size = record.size,
+                      .modified = record.modified});
+    }
+
+    _vertices = blob(bytes,
+                     header.verticesOffset,
+                     std::uint64_t{header.vertexCount} * header.vertexStride);
+    _indices = blob(bytes,
+                    header.indicesOffset,
+                    std::uint64_t{header.indexCount} * indexTypeSize(header.indexType));
+}
+
+std::uint64_t
+CookedMesh::sourceHash() const
+{
+    return _sourceHash;
+}
+
+std::uint64_t
+CookedMesh::cookerHash() const
+{
+    return _cookerHash;
+}
+
+const std::vector<FileStamp>&
+CookedMesh::sourceFiles() const
+{
+    return _sourceFiles;
+}
+
+bool
+CookedMesh::upToDate(const std::uint64_t cookerHash) const
+{
+    return _cookerHash == cookerHash and not _sourceFiles.empty()
+           and std::ranges::all_of(_sourceFiles, &FileStamp::current);
+}
+
+const VertexFormat&
+CookedMesh::format() const
+{
+    return _format;
+}
+
+const std::vector<MeshLod>&
+CookedMesh::lods() const
+{
+    return _lods;
+}
+
+const glm::vec3&
+CookedMesh::boundsMin() const
+{
+    return _boundsMin;
+}
+
+const glm::vec3&
+CookedMesh::boundsMax() const
+{
+    return _boundsMax;
+}
+
+GLsizei
+CookedMesh::vertexCount() const
+{
+    return _vertexCount;
+}
+
+GLsizei
+CookedMesh::indexCount() const
+{
+    return _indexCount;
+}
+
+GLenum
+CookedMesh::indexType() const
+{
+    return _indexType;
+}
+
+std::span<const std::byte>
+CookedMesh::vertices() const
+{
+    return _vertices;
+}
+
+std::span<const std::byte>
+CookedMesh::indices() const
+{
+    return _indices;
+}
+
+Mesh
+CookedMesh::upload() const
+{
+    Mesh mesh{_vertices.data(),
+              static_cast<GLsizeiptr>(_vertices.size()),
+              _format,
+              _indices.data(),
+              _indexCount,
+              _indexType};
+    mesh.setLods(_lods);
+    return mesh;
+}
+
+CookedMesh
+loadOrCookMesh(const std::filesystem::path& sourcePath,
+               const std::filesystem::path& cachePath,
+               const MeshCookOptions& options)
+{
+    const auto cooker = cookerHash(options);
+    if (std::filesystem::exists(cachePath)) {
+        try {
+            CookedMesh cooked{cachePath};
+            if (cooked.upToDate(cooker)) {
+                return cooked;
+            }
+            SPDLOG_INFO("Cooked mesh <{}> is stale", cachePath.string());
+        } catch (const std::runtime_error& error) {
+            SPDLOG_WARN("Unable to use cooked mesh <{}>: {}", cachePath.string(), error.what());
+        }
+    }
+
+    auto mesh = MeshData::load(sourcePath);
+    // Content is hashed only when cooking, loading compares file stamps
+    MeshSource source{.hash = assetHash(mesh.files, cooker), .cookerHash = cooker, .files = {}};
+    for (const auto& file : mesh.files) {
+        source.files.push_back(FileStamp::of(file));
+    }
+    if (options.maxLods > 1) {
+        generateLods(mesh, options.maxLods, options.lodReduction);
+    }
+    if (options.optimize) {
+        optimizeMesh(mesh);
+    }
+    cookMesh(mesh, cachePath, source);
+    SPDLOG_INFO("Cooked mesh <{}> into <{}>", sourcePath.string(), cachePath.string());
+    return CookedMesh{cachePath};
+}
+
+} // namespace glesy
@@ -0,0 +1,52 @@
+#include "glesy/MeshData.hpp"
+
+#include "glesy/Indices.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+namespace glesy {
+
+static_assert(sizeof(MeshVertex) == MeshVertexLayout::kStride);
+
+MeshData
+MeshData::load(const std::filesystem::path& filePath)
+{
+    auto extension = filePath.extension().string();
+    std::ranges::transform(extension, extension.begin(), [](const unsigned char ch) {
+        return static_cast<char>(std::tolower(ch));
+    });
+
+    if (extension == ".obj") {
+        return loadObj(filePath);
+    }
+    if (extension == ".gltf" or extension == ".glb") {
+        return loadGltf(filePath);
+    }
+    throw std::runtime_error{"Unsupported mesh file format"};
+}
+
+Mesh
+MeshData::upload(const GLenum primitive) const
+{
+    if (primitive == GL_TRIANGLE_STRIP) {
+        if (lods.size() > 1) {
+            throw std::invalid_argument{"Triangle strips don't support levels of detail"};
+        }
+        const auto strips = stripify(indices);
+        return Mesh{std::span{vertices}, MeshVertexLayout::format(), std::span{strips}, primitive};
+    }
+    if (primitive != GL_TRIANGLES) {
+        throw std::invalid_argument{"Unsupported mesh primitive"};
+    }
+    Mesh mesh{std::span{vertices}, MeshVertexLayout::format(), std::span{indices}};
+    if (not lods.empty()) {
+        mesh.setLods(lods);
+    }
+    return mesh;
+}
+
+} // namespace glesy
@@ -0,0 +1,31 @@
+#include "glesy/MeshLod.hpp"
+
+#include <cmath>
+
+namespace glesy {
+
+float
+lodScreenScale(const float fovY, const float viewportHeight)
+{
+    return viewportHeight / (2.0f * std::tan(fovY * 0.5f));
+}
+
+std::size_t
+selectLod(const std::span<const MeshLod> lods,
+          const float distance,
+          const float screenScale,
+          const float maxPixelError)
+{
+    if (distance <= 0.0f) {
+        return 0;
+    }
+    // Errors grow with level, so the first acceptable level from the end is the coarsest one
+    for (std::size_t lod = lods.size(); lod > 1; --lod) {
+        if (lods[lod - 1].error * screenScale / distance <= maxPixelError) {
+            return lod - 1;
+        }
+    }
+    return 0;
+}
+
+} // namespace glesy
@@ -0,0 +1,356 @@
+#include "glesy/MeshOptimizer.hpp"
+
+#include <glm/geometric.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <numeric>
+
+namespace glesy {
+
+namespace {
+
+constexpr GLuint kUnused{~0U};
+/** Do not split clusters into too small pieces (sorting would break cache locality) */
+constexpr std::size_t kMinClusterTriangles{8};
+
+/**
+ * Triangles adjacent to every vertex in compressed form
+ */
+struct Adjacency {
+    std::vector<std::size_t> offsets;
+    std::vector<std::size_t> triangles;
+};
+
+Adjacency
+buildAdjacency(const std::span<const GLuint> indices, const std::size_t vertexCount)
+{
+    Adjacency adjacency;
+    adjacency.offsets.assign(vertexCount + 1, 0);
+    for (const GLuint index : indices) {
+        adjacency.offsets[index + 1]++;
+    }
+    std::partial_sum(adjacency.offsets.begin(), adjacency.offsets.end(), adjacency.offsets.begin());
+
+    adjacency.triangles.resize(indices.size());
+    std::vector<std::size_t> cursor(adjacency.offsets.begin(), adjacency.offsets.end() - 1);
+    for (std::size_t corner = 0; corner < indices.size(); ++corner) {
+        adjacency.triangles[cursor[indices[corner]]++] = corner / 3;
+    }
+    return adjacency;
+}
+
+/**
+ * Count cache misses of triangles range with cold FIFO cache
+ */
+class FifoCache {
+public:
+    FifoCache(const std::size_t vertexCount, const std::size_t cacheSize)
+        : _timestamps(vertexCount, 0)
+        , _cacheSize{cacheSize}
+        , _time{cacheSize + 1}
+    {
+    }
+
+    bool
+    access(const GLuint vertex)
+    {
+        if (_time - _timestamps[vertex] > _cacheSize) {
+            _timestamps[vertex] = _time++;
+            return false;
+        }
+        return true;
+    }
+
+    void
+    reset()
+    {
+        // Advance time far enough to make every entry stale
+        _time += _cacheSize + 1;
+    }
+
+private:
+    std::vector<std::size_t> _timestamps;
+    std::size_t _cacheSize{};
+    std::size_t _time{};
+};
+
+} // namespace
+
+VertexCacheStats
+analyzeVertexCache(const std::span<const GLuint> indices,
+                   const std::size_t vertexCount,
+                   const std::size_t cacheSize)
+{
+    if (indices.empty()) {
+        return {};
+    }
+
+    FifoCache cache{vertexCount, cacheSize};
+    std::vector<bool> used(vertexCount, false);
+    std::size_t misses{};
+    std::size_t usedCount{};
+    for (const GLuint index : indices) {
+        if (not cache.access(index)) {
+            ++misses;
+        }
+        if (not used[index]) {
+            used[index] = true;
+            ++usedCount;
+        }
+    }
+
+    return {
+        .acmr = static_cast<float>(misses) / static_cast<float>(indices.size() / 3),
+        .atvr = static_cast<float>(misses) / static_cast<float>(usedCount),
+    };
+}
+
+std::vector<GLuint>
+optimizeVertexCache(const std::span<const GLuint> indices,
+                    const std::size_t vertexCount,
+                    const std::size_t cacheSize,
+                    std::vector<std::size_t>* clusters)
+{
+    const std::size_t triangleCount = indices.size() / 3;
+    std::vector<GLuint> output;
+    output.reserve(triangleCount * 3);
+    if (clusters != nullptr) {
+        clusters->clear();
+    }
+    if (triangleCount == 0) {
+        return output;
+    }
+
+    const Adjacency adjacency = buildAdjacency(indices, vertexCount);
+    std::vector<std::size_t> live(vertexCount);
+    for (std::size_t vertex = 0; vertex < vertexCount; ++vertex) {
+        live[vertex] = adjacency.offsets[vertex + 1] - adjacency.offsets[vertex];
+    }
+    std::vector<std::size_t> cacheTime(vertexCount, 0);
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<GLuint> deadEnd;
+    std::vector<GLuint> candidates;
+    std::size_t time{cacheSize + 1};
+    std::size_t cursor{};
+
+    const auto skipDeadEnd = [&]() -> GLuint {
+        while (not deadEnd.empty()) {
+            const GLuint vertex = deadEnd.back();
+            deadEnd.pop_back();
+            if (live[vertex] > 0) {
+                return vertex;
+            }
+        }
+        while (cursor < vertexCount) {
+            if (live[cursor] > 0) {
+                return static_cast<GLuint>(cursor);
+            }
+            ++cursor;
+        }
+        return kUnused;
+    };
+
+    GLuint fanning = skipDeadEnd();
+    if (clusters != nullptr) {
+        clusters->push_back(0);
+    }
+    while (fanning != kUnused) {
+        candidates.clear();
+        for (std::size_t i = adjacency.offsets[fanning]; i < adjacency.offsets[fanning + 1]; ++i) {
+            const std::size_t triangle = adjacency.triangles[i];
+            if (emitted[triangle]) {
+                continue;
+            }
+            emitted[triangle] = true;
+            for (std::size_t corner = 0; corner < 3; ++corner) {
+                const GLuint vertex = indices[triangle * 3 + corner];
+                output.push_back(vertex);
+                deadEnd.push_back(vertex);
+                candidates.push_back(vertex);
+                live[vertex]--;
+                if (time - cacheTime[vertex] > cacheSize) {
+                    cacheTime[vertex] = time++;
+                }
+            }
+        }
+
+        // Prefer vertex which stays in cache after its remaining triangles are emitted
+        GLuint next{kUnused};
+        std::size_t bestPriority{};
+        for (const GLuint vertex : candidates) {
+            if (live[vertex] == 0) {
+                continue;
+            }
+            std::size_t priority{};
+            if (time - cacheTime[vertex] + 2 * live[vertex] <= cacheSize) {
+                priority = time - cacheTime[vertex];
+            }
+            if (next == kUnused or priority > bestPriority) {
+                bestPriority = priority;
+                next = vertex;
+            }
+        }
+        if (next == kUnused) {
+            next = skipDeadEnd();
+            if (next != kUnused and clusters != nullptr and output.size() / 3 < triangleCount) {
+                clusters->push_back(output.size() / 3);
+            }
+        }
+        fanning = next;
+    }
+    return output;
+}
+
+std::vector<GLuint>
+optimizeOverdraw(const std::span<const GLuint> indices,
+                 const std::span<const std::size_t> clusters,
+                 const std::span<const MeshVertex> vertices,
+                 const std::size_t cacheSize,
+                 const float threshold)
+{
+    const std::size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) {
+        return {};
+    }
+
+    // Split hard clusters into smaller ones while cache efficiency stays acceptable
+    FifoCache cache{vertices.size(), cacheSize};
+    const auto countMisses = [&](const std::size_t begin, const std::size_t end) {
+        cache.reset();
+        std::size_t misses{};
+        for (std::size_t corner = begin * 3; corner < end * 3; ++corner) {
+            misses += cache.access(indices[corner]) ? 0 : 1;
+        }
+        return misses;
+    };
+
+    std::vector<std::size_t> boundaries;
+    for (std::size_t cluster = 0; cluster < clusters.size(); ++cluster) {
+        const std::size_t begin = clusters[cluster];
+        const std::size_t end
+            = (cluster + 1 < clusters.size()) ? clusters[cluster + 1] : triangleCount;
+        const float clusterAcmr = static_cast<float>(countMisses(begin, end))
+                                  / static_cast<float>(std::max<std::size_t>(end - begin, 1));
+
+        boundaries.push_back(begin);
+        cache.reset();
+        std::size_t start{begin};
+        std::size_t misses{};
+        for (std::size_t triangle = begin; triangle < end; ++triangle) {
+            for (std::size_t corner = 0; corner < 3; ++corner) {
+                misses += cache.access(indices[triangle * 3 + corner]) ? 0 : 1;
+            }
+            const std::size_t size = triangle + 1 - start;
+            const float acmr = static_cast<float>(misses) / static_cast<float>(size);
+            if (size >= kMinClusterTriangles and end - (triangle + 1) >= kMinClusterTriangles
+                and acmr <= clusterAcmr * threshold) {
+                boundaries.push_back(triangle + 1);
+                start = triangle + 1;
+                misses = 0;
+                cache.reset();
+            }
+        }
+    }
+    boundaries.push_back(triangleCount);
+
+    // Sort clusters by how much they face away from the mesh center
+    glm::vec3 meshCenter{0.0f};
+    for (const auto& vertex : vertices) {
+        meshCenter += vertex.position;
+    }
+    meshCenter /= static_cast<float>(std::max<std::size_t>(vertices.size(), 1));
+
+    const std::size_t clusterCount = boundaries.size() - 1;
+    std::vector<float> sortKeys(clusterCount);
+    for (std::size_t cluster = 0; cluster < clusterCount; ++cluster) {
+        glm::vec3 center{0.0f};
+        glm::vec3 normal{0.0f};
+        float area{};
+        for (std::size_t triangle = boundaries[cluster]; triangle < boundaries[cluster + 1];
+             ++triangle) {
+            const auto& p0 = vertices[indices[triangle * 3 + 0]].position;
+            const auto& p1 = vertices[indices[triangle * 3 + 1]].position;
+            const auto& p2 = vertices[indices[triangle * 3 + 2]].position;
+            const glm::vec3 faceNormal = glm::cross(p1 - p0, p2 - p0);
+            const float faceArea = glm::length(faceNormal);
+            center += (p0 + p1 + p2) * (faceArea / 3.0f);
+            normal += faceNormal;
+            area += faceArea;
+        }
+        if (area > 0.0f) {
+            center /= area;
+        }
+        const float normalLength = glm::length(normal);
+        sortKeys[cluster]
+            = (normalLength > 0.0f) ? glm::dot(center - meshCenter, normal / normalLength) : 0.0f;
+    }
+
+    std::vector<std::size_t> order(clusterCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::stable_sort(order, [&](const std::size_t lhs, const std::size_t rhs) {
+        return sortKeys[lhs] > sortKeys[rhs];
+    });
+
+    std::vector<GLuint> output;
+    output.reserve(indices.size());
+    for (const std::size_t cluster : order) {
+        output.insert(output.end(),
+                      indices.begin() + static_cast<std::ptrdiff_t>(boundaries[cluster] * 3),
+                      indices.begin() + static_cast<std::ptrdiff_t>(boundaries[cluster + 1] * 3));
+    }
+    return output;
+}
+
+void
+optimizeVertexFetch(MeshData& mesh)
+{
+    std::vector<GLuint> remap(mesh.vertices.size(), kUnused);
+    std::vector<MeshVertex> vertices;
+    vertices.reserve(mesh.vertices.size());
+    for (GLuint& index : mesh.indices) {
+        if (remap[index] == kUnused) {
+            remap[index] = static_cast<GLuint>(vertices.size());
+            vertices.push_back(mesh.vertices[index]);
+        }
+        index = remap[index];
+    }
+    mesh.vertices = std::move(vertices);
+}
+
+MeshOptimizationReport
+optimizeMesh(MeshData& mesh, const std::size_t cacheSize, const float overdrawThreshold)
+{
+    // Levels of detail are optimized independently, report covers the full detail one
+    std::vector<MeshLod> lods = mesh.lods;
+    if (lods.empty()) {
+        lods.push_back(MeshLod{.indexCount = static_cast<GLuint>(mesh.indices.size())});
+    }
+    const auto lodIndices = [&mesh](const MeshLod& lod) {
+        return std::span{mesh.indices}.subspan(lod.firstIndex, lod.indexCount);
+    };
+
+    MeshOptimizationReport report;
+    report.before = analyzeVertexCache(lodIndices(lods.front()), mesh.vertices.size(), cacheSize);
+
+    for (const auto& lod : lods) {
+        const auto indices = lodIndices(lod);
+        std::vector<std::size_t> clusters;
+        auto optimized = optimizeVertexCache(indices, mesh.vertices.size(), cacheSize, &clusters);
+        optimized
+            = optimizeOverdraw(optimized, clusters, mesh.vertices, cacheSize, overdrawThreshold);
+        std::ranges::copy(optimized, indices.begin());
+    }
+    optimizeVertexFetch(mesh);
+
+    report.after = analyzeVertexCache(lodIndices(lods.front()), mesh.vertices.size(), cacheSize);
+    SPDLOG_INFO("Mesh optimized: ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}",
+                report.before.acmr,
+                report.after.acmr,
+                report.before.atvr,
+                report.after.atvr);
+    return report;
+}
+
+} // namespace glesy
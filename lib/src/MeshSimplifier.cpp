@@ -0,0 +1,412 @@
+#include "glesy/MeshSimplifier.hpp"
+
+#include <glm/geometric.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <unordered_map>
+
+namespace glesy {
+
+namespace {
+
+constexpr GLuint kNoCollapse{~0U};
+constexpr std::size_t kMaxPasses{64};
+/** Level is not kept if it removes less than this fraction of triangles */
+constexpr float kMinLodProgress{0.1f};
+
+/**
+ * Symmetric 4x4 matrix of plane equations sum with total area weight
+ */
+struct Quadric {
+    double a00{}, a01{}, a02{}, a11{}, a12{}, a22{};
+    double b0{}, b1{}, b2{};
+    double c{};
+    double weight{};
+
+    static Quadric
+    fromPlane(const glm::vec3& normal, const double d, const double weight)
+    {
+        const double x = normal.x;
+        const double y = normal.y;
+        const double z = normal.z;
+        return Quadric{.a00 = weight * x * x,
+                       .a01 = weight * x * y,
+                       .a02 = weight * x * z,
+                       .a11 = weight * y * y,
+                       .a12 = weight * y * z,
+                       .a22 = weight * z * z,
+                       .b0 = weight * x * d,
+                       .b1 = weight * y * d,
+                       .b2 = weight * z * d,
+                       .c = weight * d * d,
+                       .weight = weight};
+    }
+
+    Quadric&
+    operator+=(const Quadric& other)
+    {
+        a00 += other.a00;
+        a01 += other.a01;
+        a02 += other.a02;
+        a11 += other.a11;
+        a12 += other.a12;
+        a22 += other.a22;
+        b0 += other.b0;
+        b1 += other.b1;
+        b2 += other.b2;
+        c += other.c;
+        weight += other.weight;
+        return *this;
+    }
+
+    /**
+     * Get weighted average of squared distances from point to accumulated planes
+     */
+    [[nodiscard]] double
+    error(const glm::vec3& p) const
+    {
+        const double x = p.x;
+        const double y = p.y;
+        const double z = p.z;
+        const double value = a00 * x * x + a11 * y * y + a22 * z * z
+                             + 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z)
+                             + 2.0 * (b0 * x + b1 * y + b2 * z) + c;
+        return (weight > 0.0) ? std::abs(value) / weight : 0.0;
+    }
+};
+
+struct PositionHash {
+    std::size_t
+    operator()(const glm::vec3& p) const
+    {
+        const auto x = std::bit_cast<std::uint32_t>(p.x);
+        const auto y = std::bit_cast<std::uint32_t>(p.y);
+        const auto z = std::bit_cast<std::uint32_t>(p.z);
+        return (x * 73856093U) ^ (y * 19349663U) ^ (z * 83492791U);
+    }
+};
+
+struct Collapse {
+    GLuint source{};
+    GLuint target{};
+    double cost{};
+};
+
+/**
+ * Triangles adjacent to every vertex in compressed form
+ */
+struct Adjacency {
+    std::vector<std::size_t> offsets;
+    std::vector<std::size_t> triangles;
+
+    [[nodiscard]] std::span<const std::size_t>
+    around(const GLuint vertex) const
+    {
+        return std::span{triangles}.subspan(offsets[vertex], offsets[vertex + 1] - offsets[vertex]);
+    }
+};
+
+Adjacency
+buildAdjacency(const std::span<const GLuint> indices,
+               const std::span<const GLuint> canonical,
+               const std::size_t vertexCount)
+{
+    Adjacency adjacency;
+    adjacency.offsets.assign(vertexCount + 1, 0);
+    for (const GLuint index : indices) {
+        adjacency.offsets[canonical[index] + 1]++;
+    }
+    std::partial_sum(adjacency.offsets.begin(), adjacency.offsets.end(), adjacency.offsets.begin());
+
+    adjacency.triangles.resize(indices.size());
+    std::vector<std::size_t> cursor(adjacency.offsets.begin(), adjacency.offsets.end() - 1);
+    for (std::size_t corner = 0; corner < indices.size(); ++corner) {
+        adjacency.triangles[cursor[canonical[indices[corner]]]++] = corner / 3;
+    }
+    return adjacency;
+}
+
+std::uint64_t
+edgeKey(const GLuint from, const GLuint to)
+{
+    return (static_cast<std::uint64_t>(from) << 32U) | to;
+}
+
+/**
+ * Map every vertex to the first vertex with the same position
+ */
+std::vector<GLuint>
+buildCanonical(const std::span<const MeshVertex> vertices)
+{
+    std::unordered_map<glm::vec3, GLuint, PositionHash> firstByPosition;
+    firstByPosition.reserve(vertices.size());
+    std::vector<GLuint> canonical(vertices.size());
+    for (std::size_t vertex = 0; vertex < vertices.size(); ++vertex) {
+        const auto [it, _] = firstByPosition.try_emplace(vertices[vertex].position,
+                                                         static_cast<GLuint>(vertex));
+        canonical[vertex] = it->second;
+    }
+    return canonical;
+}
+
+/**
+ * Lock positions on mesh border, non-manifold edges and attribute seams
+ */
+std::vector<bool>
+findLocked(const std::span<const GLuint> indices,
+           const std::span<const GLuint> canonical,
+           const std::size_t vertexCount)
+{
+    std::vector<bool> locked(vertexCount, false);
+
+    std::vector<GLuint> wedge(vertexCount, kNoCollapse);
+    for (const GLuint index : indices) {
+        GLuint& first = wedge[canonical[index]];
+        if (first == kNoCollapse) {
+            first = index;
+        } else if (first != index) {
+            locked[canonical[index]] = true;
+        }
+    }
+
+    std::vector<std::uint64_t> edges;
+    edges.reserve(indices.size());
+    for (std::size_t corner = 0; corner < indices.size(); ++corner) {
+        const std::size_t next = corner - corner % 3 + (corner + 1) % 3;
+        edges.push_back(edgeKey(canonical[indices[corner]], canonical[indices[next]]));
+    }
+    std::ranges::sort(edges);
+    for (std::size_t edge = 0; edge < edges.size(); ++edge) {
+        const auto from = static_cast<GLuint>(edges[edge] >> 32U);
+        const auto to = static_cast<GLuint>(edges[edge]);
+        const bool duplicated = (edge + 1 < edges.size() and edges[edge + 1] == edges[edge]);
+        if (duplicated or not std::ranges::binary_search(edges, edgeKey(to, from))) {
+            locked[from] = true;
+            locked[to] = true;
+        }
+    }
+    return locked;
+}
+
+glm::vec3
+triangleNormal(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2)
+{
+    return glm::cross(p1 - p0, p2 - p0);
+}
+
+/**
+ * Check that moving source vertex to target position doesn't flip adjacent triangles
+ */
+bool
+preservesOrientation(const std::span<const GLuint> indices,
+                     const std::span<const GLuint> canonical,
+                     const std::span<const glm::vec3> positions,
+                     const Adjacency& adjacency,
+                     const GLuint source,
+                     const GLuint target)
+{
+    for (const std::size_t triangle : adjacency.around(source)) {
+        std::array<GLuint, 3> corners{};
+        for (std::size_t corner = 0; corner < 3; ++corner) {
+            corners[corner] = canonical[indices[triangle * 3 + corner]];
+        }
+        if (std::ranges::find(corners, target) != corners.end()) {
+            // Triangle becomes degenerate and is removed
+            continue;
+        }
+        std::array<glm::vec3, 3> moved{};
+        for (std::size_t corner = 0; corner < 3; ++corner) {
+            moved[corner] = (corners[corner] == source) ? positions[target]
+                                                        : positions[corners[corner]];
+        }
+        const auto before = triangleNormal(
+            positions[corners[0]], positions[corners[1]], positions[corners[2]]);
+        const auto after = triangleNormal(moved[0], moved[1], moved[2]);
+        if (glm::dot(before, after) <= 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+std::vector<GLuint>
+simplifyMesh(const std::span<const GLuint> indices,
+             const std::span<const MeshVertex> vertices,
+             const std::size_t targetIndexCount,
+             const float targetError,
+             float* resultError)
+{
+    const std::size_t vertexCount = vertices.size();
+    std::vector<GLuint> result(indices.begin(), indices.end());
+    if (resultError != nullptr) {
+        *resultError = 0.0f;
+    }
+    if (vertexCount == 0 or result.size() <= targetIndexCount) {
+        return result;
+    }
+
+    // Work in normalized coordinates, so errors don't depend on mesh scale
+    glm::vec3 minimum{std::numeric_limits<float>::max()};
+    glm::vec3 maximum{std::numeric_limits<float>::lowest()};
+    for (const auto& vertex : vertices) {
+        minimum = glm::min(minimum, vertex.position);
+        maximum = glm::max(maximum, vertex.position);
+    }
+    const glm::vec3 size = maximum - minimum;
+    const float extent = std::max({size.x, size.y, size.z, std::numeric_limits<float>::min()});
+    std::vector<glm::vec3> positions(vertexCount);
+    for (std::size_t vertex = 0; vertex < vertexCount; ++vertex) {
+        positions[vertex] = (vertices[vertex].position - minimum) / extent;
+    }
+
+    auto canonical = buildCanonical(vertices);
+    const auto locked = findLocked(result, canonical, vertexCount);
+
+    std::vector<Quadric> quadrics(vertexCount);
+    for (std::size_t triangle = 0; triangle < result.size() / 3; ++triangle) {
+        const GLuint v0 = canonical[result[triangle * 3 + 0]];
+        const GLuint v1 = canonical[result[triangle * 3 + 1]];
+        const GLuint v2 = canonical[result[triangle * 3 + 2]];
+        const auto normal = triangleNormal(positions[v0], positions[v1], positions[v2]);
+        const float area = glm::length(normal);
+        if (area <= 0.0f) {
+            continue;
+        }
+        const glm::vec3 unit = normal / area;
+        const auto quadric
+            = Quadric::fromPlane(unit, -glm::dot(unit, positions[v0]), 0.5 * area);
+        quadrics[v0] += quadric;
+        quadrics[v1] += quadric;
+        quadrics[v2] += quadric;
+    }
+
+    const double normalizedError = std::max(targetError, 0.0f) / extent;
+    const double errorLimit = normalizedError * normalizedError;
+    double maxCost{};
+    std::vector<Collapse> candidates;
+    std::vector<GLuint> remap(vertexCount);
+    std::vector<bool> touched(vertexCount);
+    for (std::size_t pass = 0; pass < kMaxPasses and result.size() > targetIndexCount; ++pass) {
+        const auto adjacency = buildAdjacency(result, canonical, vertexCount);
+
+        candidates.clear();
+        for (std::size_t corner = 0; corner < result.size(); ++corner) {
+            const std::size_t next = corner - corner % 3 + (corner + 1) % 3;
+            const GLuint source = result[corner];
+            const GLuint target = result[next];
+            const GLuint from = canonical[source];
+            const GLuint to = canonical[target];
+            if (from == to or locked[from]) {
+                continue;
+            }
+            Quadric quadric = quadrics[from];
+            quadric += quadrics[to];
+            candidates.push_back({source, target, quadric.error(positions[to])});
+        }
+        std::ranges::sort(candidates, {}, &Collapse::cost);
+
+        std::iota(remap.begin(), remap.end(), GLuint{0});
+        touched.assign(vertexCount, false);
+        const std::size_t trianglesToRemove = (result.size() - targetIndexCount) / 3;
+        std::size_t removed{};
+        for (const auto& candidate : candidates) {
+            if (candidate.cost > errorLimit or removed >= trianglesToRemove) {
+                break;
+            }
+            const GLuint from = canonical[candidate.source];
+            const GLuint to = canonical[candidate.target];
+            if (touched[from] or touched[to]
+                or not preservesOrientation(
+                    result, canonical, positions, adjacency, from, to)) {
+                continue;
+            }
+            // Lock whole neighbourhood, so orientation checks stay valid within the pass
+            for (const std::size_t triangle : adjacency.around(from)) {
+                bool degenerate{false};
+                for (std::size_t corner = 0; corner < 3; ++corner) {
+                    const GLuint vertex = canonical[result[triangle * 3 + corner]];
+                    touched[vertex] = true;
+                    degenerate = degenerate or (vertex == to);
+                }
+                removed += degenerate ? 1 : 0;
+            }
+            remap[candidate.source] = candidate.target;
+            quadrics[to] += quadrics[from];
+            maxCost = std::max(maxCost, candidate.cost);
+        }
+        if (removed == 0) {
+            break;
+        }
+
+        // Apply collapses and drop triangles which became degenerate
+        std::size_t write{};
+        for (std::size_t triangle = 0; triangle < result.size() / 3; ++triangle) {
+            const GLuint v0 = remap[result[triangle * 3 + 0]];
+            const GLuint v1 = remap[result[triangle * 3 + 1]];
+            const GLuint v2 = remap[result[triangle * 3 + 2]];
+            if (canonical[v0] == canonical[v1] or canonical[v1] == canonical[v2]
+                or canonical[v0] == canonical[v2]) {
+                continue;
+            }
+            result[write++] = v0;
+            result[write++] = v1;
+            result[write++] = v2;
+        }
+        result.resize(write);
+    }
+
+    if (resultError != nullptr) {
+        *resultError = static_cast<float>(std::sqrt(maxCost)) * extent;
+    }
+    return result;
+}
+
+void
+generateLods(MeshData& mesh, const std::size_t maxLods, const float reduction, const float maxError)
+{
+    const GLuint fullCount = mesh.lods.empty() ? static_cast<GLuint>(mesh.indices.size())
+                                               : mesh.lods.front().indexCount;
+    mesh.indices.resize(fullCount);
+    mesh.lods.assign(1, MeshLod{.firstIndex = 0, .indexCount = fullCount, .error = 0.0f});
+
+    std::vector<GLuint> previous(mesh.indices);
+    while (mesh.lods.size() < maxLods) {
+        const auto target = static_cast<std::size_t>(static_cast<float>(previous.size() / 3)
+                                                     * reduction)
+                            * 3;
+        const float remainingError = maxError - mesh.lods.back().error;
+        if (remainingError <= 0.0f) {
+            break;
+        }
+        float error{};
+        auto simplified = simplifyMesh(
+            previous, mesh.vertices, target, remainingError, &error);
+        const auto progress = static_cast<float>(previous.size() - simplified.size())
+                              / static_cast<float>(previous.size());
+        if (simplified.empty() or progress < kMinLodProgress) {
+            break;
+        }
+        // Every level is simplified from the previous one, so deviations accumulate
+        mesh.lods.push_back(MeshLod{.firstIndex = static_cast<GLuint>(mesh.indices.size()),
+                                    .indexCount = static_cast<GLuint>(simplified.size()),
+                                    .error = mesh.lods.back().error + error});
+        mesh.indices.insert(mesh.indices.end(), simplified.begin(), simplified.end());
+        previous = std::move(simplified);
+    }
+
+    SPDLOG_INFO("Generated {} level(s) of detail: {} -> {} triangles",
+                mesh.lods.size(),
+                fullCount / 3,
+                mesh.lods.back().indexCount / 3);
+}
+
+} // namespace glesy
@@ -0,0 +1,333 @@
+#include "glesy/Meshlet.hpp"
+
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) and defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace glesy {
+
+namespace {
+
+constexpr std::size_t kLanes{4};
+constexpr std::uint32_t kNoMeshlet{~0U};
+
+std::size_t
+paddedSize(const std::size_t count)
+{
+    return (count + kLanes - 1) / kLanes * kLanes;
+}
+
+Meshlet
+makeMeshlet(const std::span<const GLuint> indices,
+            const std::span<const MeshVertex> vertices,
+            const std::size_t firstIndex)
+{
+    Meshlet meshlet{.firstIndex = static_cast<GLuint>(firstIndex),
+                    .indexCount = static_cast<GLuint>(indices.size())};
+
+    glm::vec3 minimum{std::numeric_limits<float>::max()};
+    glm::vec3 maximum{std::numeric_limits<float>::lowest()};
+    for (const GLuint index : indices) {
+        minimum = glm::min(minimum, vertices[index].position);
+        maximum = glm::max(maximum, vertices[index].position);
+    }
+    meshlet.center = (minimum + maximum) * 0.5f;
+    for (const GLuint index : indices) {
+        meshlet.radius
+            = std::max(meshlet.radius, glm::length(vertices[index].position - meshlet.center));
+    }
+
+    std::vector<glm::vec3> normals;
+    normals.reserve(indices.size() / 3);
+    glm::vec3 axis{0.0f};
+    for (std::size_t corner = 0; corner < indices.size(); corner += 3) {
+        const auto& p0 = vertices[indices[corner + 0]].position;
+        const auto& p1 = vertices[indices[corner + 1]].position;
+        const auto& p2 = vertices[indices[corner + 2]].position;
+        const auto normal = glm::cross(p1 - p0, p2 - p0);
+        const float length = glm::length(normal);
+        if (length > 0.0f) {
+            normals.push_back(normal / length);
+            axis += normals.back();
+        }
+    }
+    const float axisLength = glm::length(axis);
+    if (normals.empty() or axisLength <= 0.0f) {
+        return meshlet;
+    }
+    meshlet.coneAxis = axis / axisLength;
+
+    float minDot{1.0f};
+    for (const auto& normal : normals) {
+        minDot = std::min(minDot, glm::dot(normal, meshlet.coneAxis));
+    }
+    // Normals spread over hemisphere or more, cluster is never entirely back facing
+    if (minDot > 0.0f) {
+        meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+    }
+    return meshlet;
+}
+
+/**
+ * Test block of four meshlets
+ * @return The mask of visible meshlets (bit per meshlet)
+ */
+unsigned
+cullBlock(const float* cx,
+          const float* cy,
+          const float* cz,
+          const float* r,
+          const float* ax,
+          const float* ay,
+          const float* az,
+          const float* cutoff,
+          const Frustum& frustum,
+          const glm::vec3& camera)
+{
+#if defined(__SSE2__)
+    const __m128 centerX = _mm_loadu_ps(cx);
+    const __m128 centerY = _mm_loadu_ps(cy);
+    const __m128 centerZ = _mm_loadu_ps(cz);
+    const __m128 radius = _mm_loadu_ps(r);
+    const __m128 negativeRadius = _mm_sub_ps(_mm_setzero_ps(), radius);
+
+    __m128 visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+    for (const auto& plane : frustum.planes) {
+        const __m128 xy = _mm_add_ps(_mm_mul_ps(centerX, _mm_set1_ps(plane.x)),
+                                     _mm_mul_ps(centerY, _mm_set1_ps(plane.y)));
+        const __m128 zw
+            = _mm_add_ps(_mm_mul_ps(centerZ, _mm_set1_ps(plane.z)), _mm_set1_ps(plane.w));
+        const __m128 distance = _mm_add_ps(xy, zw);
+        visible = _mm_and_ps(visible, _mm_cmpge_ps(distance, negativeRadius));
+    }
+
+    const __m128 dx = _mm_sub_ps(centerX, _mm_set1_ps(camera.x));
+    const __m128 dy = _mm_sub_ps(centerY, _mm_set1_ps(camera.y));
+    const __m128 dz = _mm_sub_ps(centerZ, _mm_set1_ps(camera.z));
+    const __m128 dot = _mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(dx, _mm_loadu_ps(ax)), _mm_mul_ps(dy, _mm_loadu_ps(ay))),
+        _mm_mul_ps(dz, _mm_loadu_ps(az)));
+    const __m128 length = _mm_sqrt_ps(
+        _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+    const __m128 backFacing
+        = _mm_cmpge_ps(dot, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(cutoff), length), radius));
+    visible = _mm_andnot_ps(backFacing, visible);
+
+    return static_cast<unsigned>(_mm_movemask_ps(visible));
+#elif defined(__ARM_NEON) and defined(__aarch64__)
+    const float32x4_t centerX = vld1q_f32(cx);
+    const float32x4_t centerY = vld1q_f32(cy);
+    const float32x4_t centerZ = vld1q_f32(cz);
+    const float32x4_t radius = vld1q_f32(r);
+    const float32x4_t negativeRadius = vnegq_f32(radius);
+
+    uint32x4_t visible = vdupq_n_u32(~0U);
+    for (const auto& plane : frustum.planes) {
+        float32x4_t distance = vdupq_n_f32(plane.w);
+        distance = vmlaq_n_f32(distance, centerX, plane.x);
+        distance = vmlaq_n_f32(distance, centerY, plane.y);
+        distance = vmlaq_n_f32(distance, centerZ, plane.z);
+        visible = vandq_u32(visible, vcgeq_f32(distance, negativeRadius));
+    }
+
+    const float32x4_t dx = vsubq_f32(centerX, vdupq_n_f32(camera.x));
+    const float32x4_t dy = vsubq_f32(centerY, vdupq_n_f32(camera.y));
+    const float32x4_t dz = vsubq_f32(centerZ, vdupq_n_f32(camera.z));
+    float32x4_t dot = vmulq_f32(dx, vld1q_f32(ax));
+    dot = vmlaq_f32(dot, dy, vld1q_f32(ay));
+    dot = vmlaq_f32(dot, dz, vld1q_f32(az));
+    float32x4_t lengthSquared = vmulq_f32(dx, dx);
+    lengthSquared = vmlaq_f32(lengthSquared, dy, dy);
+    lengthSquared = vmlaq_f32(lengthSquared, dz, dz);
+    const float32x4_t threshold = vmlaq_f32(radius, vld1q_f32(cutoff), vsqrtq_f32(lengthSquared));
+    visible = vbicq_u32(visible, vcgeq_f32(dot, threshold));
+
+    return (vgetq_lane_u32(visible, 0) & 1U) | (vgetq_lane_u32(visible, 1) & 2U)
+           | (vgetq_lane_u32(visible, 2) & 4U) | (vgetq_lane_u32(visible, 3) & 8U);
+#else
+    unsigned mask{};
+    for (std::size_t lane = 0; lane < kLanes; ++lane) {
+        const glm::vec3 center{cx[lane], cy[lane], cz[lane]};
+        bool visible = frustum.intersects(center, r[lane]);
+        const glm::vec3 direction = center - camera;
+        const float dot = glm::dot(direction, glm::vec3{ax[lane], ay[lane], az[lane]});
+        visible = visible and dot < cutoff[lane] * glm::length(direction) + r[lane];
+        mask |= visible ? (1U << lane) : 0U;
+    }
+    return mask;
+#endif
+}
+
+} // namespace
+
+MeshletData
+buildMeshlets(const std::span<const GLuint> indices,
+              const std::span<const MeshVertex> vertices,
+              const std::size_t maxVertices,
+              const std::size_t maxTriangles)
+{
+    const std::size_t triangleCount = indices.size() / 3;
+    const std::size_t vertexCount = vertices.size();
+
+    // Triangles adjacent to every vertex in compressed form
+    std::vector<std::size_t> offsets(vertexCount + 1, 0);
+    for (const GLuint index : indices) {
+        offsets[index + 1]++;
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::vector<std::size_t> adjacency(indices.size());
+    std::vector<std::size_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (std::size_t corner = 0; corner < indices.size(); ++corner) {
+        adjacency[cursor[indices[corner]]++] = corner / 3;
+    }
+
+    MeshletData data;
+    data.indices.reserve(indices.size());
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<std::uint32_t> owner(vertexCount, kNoMeshlet);
+    std::vector<GLuint> meshletVertices;
+    meshletVertices.reserve(maxVertices);
+
+    const auto newVertices = [&](const std::size_t triangle, const std::uint32_t meshlet) {
+        std::size_t count{};
+        for (std::size_t corner = 0; corner < 3; ++corner) {
+            count += (owner[indices[triangle * 3 + corner]] != meshlet) ? 1 : 0;
+        }
+        return count;
+    };
+
+    for (std::size_t seed = 0; seed < triangleCount; ++seed) {
+        if (emitted[seed]) {
+            continue;
+        }
+        const auto meshlet = static_cast<std::uint32_t>(data.meshlets.size());
+        const std::size_t firstIndex = data.indices.size();
+        meshletVertices.clear();
+
+        std::size_t next = seed;
+        std::size_t triangles{};
+        while (next != triangleCount) {
+            emitted[next] = true;
+            for (std::size_t corner = 0; corner < 3; ++corner) {
+                const GLuint vertex = indices[next * 3 + corner];
+                if (owner[vertex] != meshlet) {
+                    owner[vertex] = meshlet;
+                    meshletVertices.push_back(vertex);
+                }
+                data.indices.push_back(vertex);
+            }
+            if (++triangles == maxTriangles) {
+                break;
+            }
+
+            // Pick adjacent triangle adding the fewest vertices
+            next = triangleCount;
+            std::size_t bestCost = 4;
+            for (const GLuint vertex : meshletVertices) {
+                for (std::size_t slot = offsets[vertex]; slot < offsets[vertex + 1]; ++slot) {
+                    const std::size_t candidate = adjacency[slot];
+                    if (emitted[candidate]) {
+                        continue;
+                    }
+                    const std::size_t cost = newVertices(candidate, meshlet);
+                    if (cost < bestCost and meshletVertices.size() + cost <= maxVertices) {
+                        bestCost = cost;
+                        next = candidate;
+                    }
+                }
+                if (bestCost == 0) {
+                    break;
+                }
+            }
+        }
+
+        data.meshlets.push_back(makeMeshlet(
+            std::span{data.indices}.subspan(firstIndex), vertices, firstIndex));
+    }
+    return data;
+}
+
+MeshletCuller::MeshletCuller(const std::span<const Meshlet> meshlets)
+    : _count{meshlets.size()}
+{
+    const std::size_t padded = paddedSize(_count);
+    // Padding lanes are masked out by count check
+    _centerX.resize(padded);
+    _centerY.resize(padded);
+    _centerZ.resize(padded);
+    _radius.resize(padded);
+    _axisX.resize(padded);
+    _axisY.resize(padded);
+    _axisZ.resize(padded);
+    _cutoff.resize(padded, 1.0f);
+    for (std::size_t index = 0; index < _count; ++index) {
+        const auto& meshlet = meshlets[index];
+        _centerX[index] = meshlet.center.x;
+        _centerY[index] = meshlet.center.y;
+        _centerZ[index] = meshlet.center.z;
+        _radius[index] = meshlet.radius;
+        _axisX[index] = meshlet.coneAxis.x;
+        _axisY[index] = meshlet.coneAxis.y;
+        _axisZ[index] = meshlet.coneAxis.z;
+        _cutoff[index] = meshlet.coneCutoff;
+    }
+}
+
+std::size_t
+MeshletCuller::cull(const Frustum& frustum,
+                    const glm::vec3& cameraPosition,
+                    std::vector<std::uint32_t>& visible) const
+{
+    visible.clear();
+    for (std::size_t block = 0; block < _count; block += kLanes) {
+        unsigned mask = cullBlock(&_centerX[block],
+                                  &_centerY[block],
+                                  &_centerZ[block],
+                                  &_radius[block],
+                                  &_axisX[block],
+                                  &_axisY[block],
+                                  &_axisZ[block],
+                                  &_cutoff[block],
+                                  frustum,
+                                  cameraPosition);
+        while (mask != 0) {
+            const auto index = block + static_cast<std::size_t>(std::countr_zero(mask));
+            if (index < _count) {
+                visible.push_back(static_cast<std::uint32_t>(index));
+            }
+            mask &= mask - 1;
+        }
+    }
+    return visible.size();
+}
+
+std::size_t
+MeshletCuller::size() const
+{
+    return _count;
+}
+
+void
+addMeshlets(DrawRun& run,
+            const GeometryHeap& heap,
+            const GeometryHeap::Handle handle,
+            const std::span<const Meshlet> meshlets,
+            const std::span<const std::uint32_t> visible)
+{
+    for (const std::uint32_t index : visible) {
+        const auto& meshlet = meshlets[index];
+        run.add(heap, handle, meshlet.firstIndex, static_cast<GLsizei>(meshlet.indexCount));
+    }
+}
+
+} // namespace glesy
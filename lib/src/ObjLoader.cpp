@@ -0,0 +1,329 @@
+#include "glesy/MeshData.hpp"
+#include "glesy/MappedFile.hpp"
+#include "glesy/Parallel.hpp"
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+
+namespace glesy {
+
+namespace {
+
+/** Chunks are made several times smaller than file / threads to balance the load */
+constexpr std::size_t kMinChunkSize{1024 * 1024};
+constexpr std::size_t kChunksPerThread{4};
+constexpr std::uint32_t kNoIndex{UINT32_MAX};
+
+enum Component : std::uint8_t { kPosition = 0, kTexCoord = 1, kNormal = 2 };
+
+/**
+ * Face corner as written in the file. Negative (relative) references are stored relative to
+ * the chunk start since the number of elements in preceding chunks is not known while parsing.
+ */
+struct RawCorner {
+    std::int64_t index[3]{};
+    std::uint8_t present{};
+    std::uint8_t relative{};
+};
+
+struct Key {
+    std::uint32_t index[3]{};
+
+    bool
+    operator==(const Key&) const
+        = default;
+};
+
+struct KeyHash {
+    std::size_t
+    operator()(const Key& key) const noexcept
+    {
+        std::uint64_t hash = 0xCBF29CE484222325ULL;
+        for (const auto value : key.index) {
+            hash = (hash ^ value) * 0x100000001B3ULL;
+        }
+        return static_cast<std::size_t>(hash ^ (hash >> 29U));
+    }
+};
+
+struct Chunk {
+    std::string_view text;
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec2> texCoords;
+    std::vector<glm::vec3> normals;
+    std::vector<RawCorner> corners;
+    // Filled by deduplication pass
+    std::vector<Key> uniqueKeys;
+    std::vector<GLuint> indices;
+};
+
+const char*
+skipSpaces(const char* p, const char* end)
+{
+    while (p < end and (*p == ' ' or *p == '\t')) {
+        ++p;
+    }
+    return p;
+}
+
+template<typename T>
+bool
+parseNumber(const char*& p, const char* end, T& value)
+{
+    p = skipSpaces(p, end);
+    if (p < end and *p == '+') {
+        ++p;
+    }
+    const auto [ptr, ec] = std::from_chars(p, end, value);
+    if (ec != std::errc{}) {
+        return false;
+    }
+    p = ptr;
+    return true;
+}
+
+template<int N>
+void
+parseVector(const char* p, const char* end, float (&out)[N])
+{
+    for (int i = 0; i < N; ++i) {
+        if (not parseNumber(p, end, out[i])) {
+            if (i == 0) {
+                throw std::runtime_error{"Invalid OBJ vertex data"};
+            }
+            break;
+        }
+    }
+}
+
+bool
+parseCorner(const char*& p, const char* end, const Chunk& chunk, RawCorner& corner)
+{
+    p = skipSpaces(p, end);
+    if (p >= end) {
+        return false;
+    }
+
+    const std::int64_t counts[3] = {
+        static_cast<std::int64_t>(chunk.positions.size()),
+        static_cast<std::int64_t>(chunk.texCoords.size()),
+        static_cast<std::int64_t>(chunk.normals.size()),
+    };
+    for (int component = kPosition; component <= kNormal; ++component) {
+        if (component > kPosition) {
+            if (p >= end or *p != '/') {
+                break;
+            }
+            ++p;
+            if (p < end and *p == '/') {
+                continue;
+            }
+        }
+        std::int64_t value{};
+        const auto [ptr, ec] = std::from_chars(p, end, value);
+        if (ec != std::errc{} or value == 0) {
+            if (component == kPosition) {
+                throw std::runtime_error{"Invalid OBJ face data"};
+            }
+            continue;
+        }
+        p = ptr;
+        corner.present |= static_cast<std::uint8_t>(1U << component);
+        if (value < 0) {
+            corner.relative |= static_cast<std::uint8_t>(1U << component);
+            corner.index[component] = counts[component] + value;
+        } else {
+            corner.index[component] = value - 1;
+        }
+    }
+    return true;
+}
+
+void
+parseChunk(Chunk& chunk)
+{
+    const char* p = chunk.text.data();
+    const char* const end = p + chunk.text.size();
+
+    std::vector<RawCorner> polygon;
+    while (p < end) {
+        const auto* eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        const char* lineEnd = (eol != nullptr) ? eol : end;
+        const char* next = (eol != nullptr) ? eol + 1 : end;
+        if (lineEnd > p and lineEnd[-1] == '\r') {
+            --lineEnd;
+        }
+
+        const char* line = skipSpaces(p, lineEnd);
+        p = next;
+        if (lineEnd - line < 2) {
+            continue;
+        }
+
+        if (line[0] == 'v' and (line[1] == ' ' or line[1] == '\t')) {
+            float value[3]{};
+            parseVector(line + 2, lineEnd, value);
+            chunk.positions.emplace_back(value[0], value[1], value[2]);
+        } else if (line[0] == 'v' and line[1] == 't') {
+            float value[2]{};
+            parseVector(line + 2, lineEnd, value);
+            chunk.texCoords.emplace_back(value[0], value[1]);
+        } else if (line[0] == 'v' and line[1] == 'n') {
+            float value[3]{};
+            parseVector(line + 2, lineEnd, value);
+            chunk.normals.emplace_back(value[0], value[1], value[2]);
+        } else if (line[0] == 'f' and (line[1] == ' ' or line[1] == '\t')) {
+            polygon.clear();
+            const char* cursor = line + 2;
+            RawCorner corner;
+            while (parseCorner(cursor, lineEnd, chunk, corner)) {
+                polygon.push_back(corner);
+                corner = {};
+            }
+            // Triangulate polygon as a fan
+            for (std::size_t i = 2; i < polygon.size(); ++i) {
+                chunk.corners.push_back(polygon[0]);
+                chunk.corners.push_back(polygon[i - 1]);
+                chunk.corners.push_back(polygon[i]);
+            }
+        }
+    }
+}
+
+std::vector<Chunk>
+splitChunks(const std::string_view text)
+{
+    const std::size_t threads = ThreadPool::instance().concurrency();
+    const std::size_t chunkSize
+        = std::max(kMinChunkSize, text.size() / (threads * kChunksPerThread) + 1);
+
+    std::vector<Chunk> chunks;
+    std::size_t begin{};
+    while (begin < text.size()) {
+        std::size_t end = std::min(text.size(), begin + chunkSize);
+        if (end < text.size()) {
+            const auto eol = text.find('\n', end);
+            end = (eol == std::string_view::npos) ? text.size() : eol + 1;
+        }
+        chunks.emplace_back().text = text.substr(begin, end - begin);
+        begin = end;
+    }
+    return chunks;
+}
+
+} // namespace
+
+MeshData
+MeshData::loadObj(const std::filesystem::path& filePath)
+{
+    const MappedFile file{filePath};
+    std::vector<Chunk> chunks = splitChunks(file.text());
+
+    auto& pool = ThreadPool::instance();
+    pool.run(chunks.size(), [&](const std::size_t index) { parseChunk(chunks[index]); });
+
+    // Resolve references into absolute indices using element counts of preceding chunks
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec2> texCoords;
+    std::vector<glm::vec3> normals;
+    std::vector<std::int64_t> bases[3];
+    for (auto& chunk : chunks) {
+        bases[kPosition].push_back(static_cast<std::int64_t>(positions.size()));
+        bases[kTexCoord].push_back(static_cast<std::int64_t>(texCoords.size()));
+        bases[kNormal].push_back(static_cast<std::int64_t>(normals.size()));
+        positions.insert(positions.end(), chunk.positions.begin(), chunk.positions.end());
+        texCoords.insert(texCoords.end(), chunk.texCoords.begin(), chunk.texCoords.end());
+        normals.insert(normals.end(), chunk.normals.begin(), chunk.normals.end());
+        chunk.positions = {};
+        chunk.texCoords = {};
+        chunk.normals = {};
+    }
+    const std::int64_t counts[3] = {
+        static_cast<std::int64_t>(positions.size()),
+        static_cast<std::int64_t>(texCoords.size()),
+        static_cast<std::int64_t>(normals.size()),
+    };
+
+    // Deduplicate vertices inside every chunk in parallel
+    pool.run(chunks.size(), [&](const std::size_t index) {
+        auto& chunk = chunks[index];
+        std::unordered_map<Key, GLuint, KeyHash> unique;
+        unique.reserve(chunk.corners.size() / 2);
+        chunk.indices.reserve(chunk.corners.size());
+        for (const auto& corner : chunk.corners) {
+            Key key;
+            for (int component = kPosition; component <= kNormal; ++component) {
+                if ((corner.present & (1U << component)) == 0) {
+                    key.index[component] = kNoIndex;
+                    continue;
+                }
+                std::int64_t value = corner.index[component];
+                if ((corner.relative & (1U << component)) != 0) {
+                    value += bases[component][index];
+                }
+                if (value < 0 or value >= counts[component]) {
+                    throw std::runtime_error{"OBJ face references missing vertex data"};
+                }
+                key.index[component] = static_cast<std::uint32_t>(value);
+            }
+            const auto [it, inserted]
+                = unique.try_emplace(key, static_cast<GLuint>(chunk.uniqueKeys.size()));
+            if (inserted) {
+                chunk.uniqueKeys.push_back(key);
+            }
+            chunk.indices.push_back(it->second);
+        }
+        chunk.corners = {};
+    });
+
+    // Merge chunk-local vertices (far fewer than corners) into the global set
+    std::unordered_map<Key, GLuint, KeyHash> unique;
+    std::vector<Key> uniqueKeys;
+    std::vector<std::vector<GLuint>> remaps(chunks.size());
+    std::vector<std::size_t> indexOffsets(chunks.size());
+    std::size_t indexCount{};
+    for (std::size_t index = 0; index < chunks.size(); ++index) {
+        auto& remap = remaps[index];
+        remap.reserve(chunks[index].uniqueKeys.size());
+        for (const auto& key : chunks[index].uniqueKeys) {
+            const auto [it, inserted]
+                = unique.try_emplace(key, static_cast<GLuint>(uniqueKeys.size()));
+            if (inserted) {
+                uniqueKeys.push_back(key);
+            }
+            remap.push_back(it->second);
+        }
+        indexOffsets[index] = indexCount;
+        indexCount += chunks[index].indices.size();
+    }
+
+    MeshData mesh;
+    mesh.indices.resize(indexCount);
+    mesh.vertices.resize(uniqueKeys.size());
+    pool.run(chunks.size(), [&](const std::size_t index) {
+        const auto& remap = remaps[index];
+        auto* out = mesh.indices.data() + indexOffsets[index];
+        for (const GLuint local : chunks[index].indices) {
+            *out++ = remap[local];
+        }
+    });
+    parallelFor(uniqueKeys.size(), 64 * 1024, [&](const std::size_t begin, const std::size_t end) {
+        for (std::size_t index = begin; index < end; ++index) {
+            const auto& key = uniqueKeys[index];
+            auto& vertex = mesh.vertices[index];
+            vertex.position = positions[key.index[kPosition]];
+            vertex.texCoord = (key.index[kTexCoord] != kNoIndex) ? texCoords[key.index[kTexCoord]]
+                                                                 : glm::vec2{0.0f};
+            vertex.normal = (key.index[kNormal] != kNoIndex) ? normals[key.index[kNormal]]
+                                                             : glm::vec3{0.0f};
+        }
+    });
+    mesh.files.push_back(filePath);
+    return mesh;
+}
+
+} // namespace glesy
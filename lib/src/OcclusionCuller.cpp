@@ -0,0 +1,242 @@
+#include "glesy/OcclusionCuller.hpp"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+namespace glesy {
+
+namespace {
+
+constexpr auto kProxyVertexShader = R"glsl(
+#version 330 core
+
+layout (location = 0) in vec3 aPosition;
+
+uniform mat4 uViewProjection;
+uniform vec3 uMinimum;
+uniform vec3 uMaximum;
+
+void main()
+{
+    gl_Position = uViewProjection * vec4(mix(uMinimum, uMaximum, aPosition), 1.0);
+}
+)glsl";
+
+constexpr auto kProxyFragmentShader = R"glsl(
+#version 330 core
+
+void main()
+{
+}
+)glsl";
+
+// clang-format off
+constexpr std::array<GLfloat, 24> kCubeVertices{
+    0.0f, 0.0f, 0.0f,  1.0f, 0.0f, 0.0f,  1.0f, 1.0f, 0.0f,  0.0f, 1.0f, 0.0f,
+    0.0f, 0.0f, 1.0f,  1.0f, 0.0f, 1.0f,  1.0f, 1.0f, 1.0f,  0.0f, 1.0f, 1.0f,
+};
+constexpr std::array<GLubyte, 36> kCubeIndices{
+    0, 2, 1,  0, 3, 2, // back
+    4, 5, 6,  4, 6, 7, // front
+    0, 1, 5,  0, 5, 4, // bottom
+    3, 7, 6,  3, 6, 2, // top
+    0, 4, 7,  0, 7, 3, // left
+    1, 2, 6,  1, 6, 5, // right
+};
+// clang-format on
+
+// Boxes closer than this to the camera may be clipped by the near plane
+constexpr float kNearMargin{0.05f};
+
+bool
+insideBox(const glm::vec3& point, const glm::vec3& minimum, const glm::vec3& maximum)
+{
+    return point.x >= minimum.x - kNearMargin and point.y >= minimum.y - kNearMargin
+           and point.z >= minimum.z - kNearMargin and point.x <= maximum.x + kNearMargin
+           and point.y <= maximum.y + kNearMargin and point.z <= maximum.z + kNearMargin;
+}
+
+} // namespace
+
+OcclusionCuller::OcclusionCuller(const std::size_t objects, const std::size_t latency)
+    : _latency{std::max<std::size_t>(latency, 1)}
+    , _shader{kProxyVertexShader, kProxyFragmentShader}
+{
+    _vertices.setData(sizeof(kCubeVertices), kCubeVertices.data());
+    const VertexFormat format{.stride = 3 * sizeof(GLfloat),
+                              .attributes = {VertexAttribute{.location = 0, .components = 3}}};
+    _vertexArray.setVertexBuffer(_vertices, format);
+    _indices.setData(sizeof(kCubeIndices), kCubeIndices.data());
+    _vertexArray.setIndexBuffer(_indices);
+
+    const auto& interface = _shader.interface();
+    _viewProjectionLocation = interface.uniformLocation("uViewProjection");
+    _minimumLocation = interface.uniformLocation("uMinimum");
+    _maximumLocation = interface.uniformLocation("uMaximum");
+
+    resize(objects);
+}
+
+OcclusionCuller::~OcclusionCuller()
+{
+    glDeleteQueries(static_cast<GLsizei>(_queries.size()), _queries.data());
+}
+
+void
+OcclusionCuller::resize(const std::size_t objects)
+{
+    glDeleteQueries(static_cast<GLsizei>(_queries.size()), _queries.data());
+    _objects = objects;
+    _queries.assign(objects * _latency, 0);
+    if (not _queries.empty()) {
+        glGenQueries(static_cast<GLsizei>(_queries.size()), _queries.data());
+    }
+    _issuedFrames.assign(_queries.size(), 0);
+    _objectStats.assign(objects, ObjectStats{});
+    _pending.clear();
+}
+
+std::size_t
+OcclusionCuller::size() const
+{
+    return _objects;
+}
+
+void
+OcclusionCuller::begin(const glm::mat4& viewProjection, const glm::vec3& cameraPosition)
+{
+    _frame++;
+    _stats = Stats{};
+    _cameraPosition = cameraPosition;
+    collect();
+
+    _shader.use();
+    glUniformMatrix4fv(_viewProjectionLocation, 1, GL_FALSE, &viewProjection[0][0]);
+    _vertexArray.bind();
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    glDepthMask(GL_FALSE);
+    glEnable(GL_DEPTH_TEST);
+    // Camera may be outside of the box but close to its back faces
+    glDisable(GL_CULL_FACE);
+}
+
+void
+OcclusionCuller::test(const std::uint32_t object,
+                      const glm::vec3& minimum,
+                      const glm::vec3& maximum)
+{
+    if (object >= _objects) {
+        throw std::out_of_range{"Invalid occlusion object index"};
+    }
+
+    const auto slot = static_cast<std::uint32_t>(_frame % _latency);
+    const std::size_t index = object * _latency + slot;
+    if (insideBox(_cameraPosition, minimum, maximum)) {
+        // Proxy would be clipped away, keep object visible
+        _issuedFrames[index] = 0;
+        _stats.skipped++;
+        return;
+    }
+    if (_issuedFrames[index] != 0) {
+        _stats.lost++;
+    }
+
+    glUniform3fv(_minimumLocation, 1, &minimum.x);
+    glUniform3fv(_maximumLocation, 1, &maximum.x);
+    glBeginQuery(GL_ANY_SAMPLES_PASSED, _queries[index]);
+    glDrawElements(
+        GL_TRIANGLES, static_cast<GLsizei>(kCubeIndices.size()), GL_UNSIGNED_BYTE, nullptr);
+    glEndQuery(GL_ANY_SAMPLES_PASSED);
+
+    _issuedFrames[index] = _frame;
+    _pending.push_back(PendingQuery{.object = object, .slot = slot, .frame = _frame});
+    _stats.tested++;
+}
+
+void
+OcclusionCuller::end()
+{
+    VertexArray::unbind();
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    glDepthMask(GL_TRUE);
+}
+
+bool
+OcclusionCuller::beginConditional(const std::uint32_t object)
+{
+    if (object >= _objects) {
+        throw std::out_of_range{"Invalid occlusion object index"};
+    }
+
+    const auto slot = static_cast<std::uint32_t>(_frame % _latency);
+    if (_issuedFrames[object * _latency + slot] != _frame) {
+        return false;
+    }
+    glBeginConditionalRender(query(object, slot), GL_QUERY_NO_WAIT);
+    _conditional = true;
+    _stats.conditional++;
+    return true;
+}
+
+void
+OcclusionCuller::endConditional()
+{
+    if (_conditional) {
+        glEndConditionalRender();
+        _conditional = false;
+    }
+}
+
+const OcclusionCuller::Stats&
+OcclusionCuller::stats() const
+{
+    return _stats;
+}
+
+const OcclusionCuller::ObjectStats&
+OcclusionCuller::objectStats(const std::uint32_t object) const
+{
+    return _objectStats.at(object);
+}
+
+void
+OcclusionCuller::collect()
+{
+    // Queries complete in submission order, stop at the first one still in flight
+    while (not _pending.empty()) {
+        const auto pending = _pending.front();
+        const std::size_t index = pending.object * _latency + pending.slot;
+        if (_issuedFrames[index] != pending.frame) {
+            // Query object was reissued (or skipped) since, its result is gone
+            _pending.pop_front();
+            continue;
+        }
+        GLint available{};
+        glGetQueryObjectiv(_queries[index], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available == GL_FALSE) {
+            break;
+        }
+        GLuint passed{};
+        glGetQueryObjectuiv(_queries[index], GL_QUERY_RESULT, &passed);
+        auto& objectStats = _objectStats[pending.object];
+        if (passed != 0) {
+            objectStats.visible++;
+            objectStats.lastVisibleFrame = std::max(objectStats.lastVisibleFrame, pending.frame);
+            _stats.visible++;
+        } else {
+            objectStats.occluded++;
+            _stats.occluded++;
+        }
+        _issuedFrames[index] = 0;
+        _pending.pop_front();
+    }
+}
+
+GLuint
+OcclusionCuller::query(const std::uint32_t object, const std::uint32_t slot) const
+{
+    return _queries[object * _latency + slot];
+}
+
+} // namespace glesy
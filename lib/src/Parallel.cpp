@@ -0,0 +1,133 @@
+#include "glesy/Parallel.hpp"
+
+#include <utility>
+
+namespace glesy {
+
+namespace {
+
+thread_local bool tInsideTask{false};
+
+} // namespace
+
+ThreadPool::ThreadPool(const std::size_t workers)
+{
+    _workers.reserve(workers);
+    for (std::size_t index = 0; index < workers; ++index) {
+        _workers.emplace_back([this] { work(); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock{_guard};
+        _stop = true;
+    }
+    _wakeUp.notify_all();
+    _workers.clear();
+}
+
+ThreadPool&
+ThreadPool::instance()
+{
+    static ThreadPool pool{std::max(1U, std::thread::hardware_concurrency()) - 1U};
+    return pool;
+}
+
+std::size_t
+ThreadPool::concurrency() const
+{
+    return _workers.size() + 1;
+}
+
+void
+ThreadPool::execute(const std::size_t tasks, const TaskFn fn, void* context)
+{
+    if (tasks == 0) {
+        return;
+    }
+    if (tInsideTask or tasks == 1 or _workers.empty()) {
+        for (std::size_t task = 0; task < tasks; ++task) {
+            fn(context, task);
+        }
+        return;
+    }
+
+    std::lock_guard submitLock{_submitGuard};
+    {
+        std::lock_guard lock{_guard};
+        _fn = fn;
+        _context = context;
+        _tasks = tasks;
+        _next = 0;
+        _pending = tasks;
+        _error = nullptr;
+        ++_generation;
+    }
+    _wakeUp.notify_all();
+
+    while (process()) {
+    }
+
+    std::unique_lock lock{_guard};
+    _done.wait(lock, [this] { return _pending == 0; });
+    _fn = nullptr;
+    if (_error) {
+        std::rethrow_exception(std::exchange(_error, nullptr));
+    }
+}
+
+void
+ThreadPool::work()
+{
+    std::size_t seen{};
+    while (true) {
+        {
+            std::unique_lock lock{_guard};
+            _wakeUp.wait(lock, [&] { return _stop or _generation != seen; });
+            if (_stop) {
+                return;
+            }
+            seen = _generation;
+        }
+        while (process()) {
+        }
+    }
+}
+
+bool
+ThreadPool::process()
+{
+    TaskFn fn{};
+    void* context{};
+    std::size_t task{};
+    {
+        std::lock_guard lock{_guard};
+        if (_fn == nullptr or _next >= _tasks) {
+            return false;
+        }
+        fn = _fn;
+        context = _context;
+        task = _next++;
+    }
+
+    tInsideTask = true;
+    try {
+        fn(context, task);
+    } catch (...) {
+        std::lock_guard lock{_guard};
+        if (not _error) {
+            _error = std::current_exception();
+        }
+    }
+    tInsideTask = false;
+
+    std::lock_guard lock{_guard};
+    if (--_pending == 0) {
+        _done.notify_all();
+    }
+    return true;
+}
+
+} // namespace glesy
@@ -0,0 +1,231 @@
+#include "glesy/PostProcessStack.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <utility>
+
+namespace glesy {
+
+namespace {
+
+// Full-screen triangle generated from vertex index, drawn without vertex buffers
+constexpr auto kVertexShader = R"glsl(
+#version 330 core
+
+out vec2 vUv;
+
+void main()
+{
+    vec2 position = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+    vUv = position;
+    gl_Position = vec4(position * 2.0 - 1.0, 0.0, 1.0);
+}
+)glsl";
+
+constexpr auto kFragmentHeader = R"glsl(
+#version 330 core
+
+in vec2 vUv;
+out vec4 fragColor;
+
+uniform sampler2D uSource;
+uniform vec2 uTexelSize;
+)glsl";
+
+} // namespace
+
+PostProcessStack::PostProcessStack(RenderTargetPool& pool, const GLenum format)
+    : _pool{pool}
+    , _format{format}
+{
+}
+
+void
+PostProcessStack::add(PostEffect effect)
+{
+    if (effect.name.empty() or find(effect.name) != _entries.end()) {
+        throw std::invalid_argument{"Post effect name is empty or already used"};
+    }
+    _entries.push_back({std::move(effect)});
+    _dirty = true;
+}
+
+void
+PostProcessStack::remove(const std::string_view name)
+{
+    const auto it = find(name);
+    if (it == _entries.end()) {
+        return;
+    }
+    _entries.erase(it);
+
+    // The name may be reused by another effect, drop programs generated with the old source
+    const std::string token = '|' + std::string{name} + '|';
+    std::erase_if(_programs, [&](const auto& item) { return item.first.contains(token); });
+    _dirty = true;
+}
+
+void
+PostProcessStack::setEnabled(const std::string_view name, const bool enabled)
+{
+    if (const auto it = find(name); it != _entries.end() and it->enabled != enabled) {
+        it->enabled = enabled;
+        _dirty = true;
+    }
+}
+
+bool
+PostProcessStack::enabled(const std::string_view name) const
+{
+    const auto it = find(name);
+    return it != _entries.end() and it->enabled;
+}
+
+void
+PostProcessStack::apply(const RenderTarget& input,
+                        const GLuint framebuffer,
+                        const GLsizei width,
+                        const GLsizei height)
+{
+    if (_dirty) {
+        build();
+    }
+
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_BLEND);
+    _vertexArray.bind();
+
+    const RenderTarget* source = &input;
+    const RenderTarget* intermediate{};
+    for (std::size_t index = 0; index < _passes.size(); ++index) {
+        const Pass& pass = _passes[index];
+        const bool last = (index + 1 == _passes.size());
+
+        const RenderTarget* target{};
+        if (last) {
+            glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        } else {
+            target = &_pool.acquire({width, height, _format});
+            const std::array<const RenderTarget*, 1> colors{target};
+            _pool.framebuffer(colors, nullptr).bind();
+        }
+        glViewport(0, 0, width, height);
+
+        const Shader& shader = *pass.shader;
+        shader.use();
+        shader.setInt("uSource", 0);
+        glUniform2f(shader.interface().uniformLocation("uTexelSize"),
+                    1.0f / static_cast<float>(source->desc().width),
+                    1.0f / static_cast<float>(source->desc().height));
+        for (const std::size_t effect : pass.effects) {
+            if (const auto& setup = _entries[effect].effect.setup) {
+                setup(shader);
+            }
+        }
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, source->id());
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+
+        if (intermediate != nullptr) {
+            _pool.release(*intermediate);
+        }
+        intermediate = target;
+        source = target;
+    }
+
+    VertexArray::unbind();
+}
+
+PostProcessStack::Stats
+PostProcessStack::stats() const
+{
+    Stats stats;
+    stats.effects = static_cast<std::size_t>(
+        std::ranges::count_if(_entries, [](const Entry& entry) { return entry.enabled; }));
+    stats.passes = _passes.size();
+    stats.programs = _programs.size();
+    return stats;
+}
+
+void
+PostProcessStack::build()
+{
+    std::vector<std::vector<std::size_t>> groups;
+    for (std::size_t index = 0; index < _entries.size(); ++index) {
+        const Entry& entry = _entries[index];
+        if (not entry.enabled) {
+            continue;
+        }
+        // Per-pixel effects join the current pass, neighborhood effects need its result stored
+        if (groups.empty() or entry.effect.neighborhood) {
+            groups.emplace_back();
+        }
+        groups.back().push_back(index);
+    }
+    if (groups.empty()) {
+        // Nothing enabled, still copy input to the output
+        groups.emplace_back();
+    }
+
+    _passes.clear();
+    for (auto& effects : groups) {
+        const Shader& shader = program(effects);
+        _passes.push_back({std::move(effects), &shader});
+    }
+    _dirty = false;
+}
+
+const Shader&
+PostProcessStack::program(const std::span<const std::size_t> effects)
+{
+    std::string key{"|"};
+    for (const std::size_t effect : effects) {
+        key += _entries[effect].effect.name + '|';
+    }
+    if (const auto it = _programs.find(key); it != _programs.end()) {
+        return *it->second;
+    }
+
+    std::string source{kFragmentHeader};
+    for (const std::size_t effect : effects) {
+        source += _entries[effect].effect.source;
+        source += '\n';
+    }
+    source += "\nvoid main()\n{\n";
+    std::size_t first{};
+    if (not effects.empty() and _entries[effects.front()].effect.neighborhood) {
+        source += "    vec4 color = " + _entries[effects.front()].effect.name + "(uSource, vUv);\n";
+        first = 1;
+    } else {
+        source += "    vec4 color = texture(uSource, vUv);\n";
+    }
+    for (const std::size_t effect : effects.subspan(first)) {
+        source += "    color = " + _entries[effect].effect.name + "(color, vUv);\n";
+    }
+    source += "    fragColor = color;\n}\n";
+
+    SPDLOG_INFO("Generate post-process program <{}>", key);
+    auto shader = std::make_unique<Shader>(kVertexShader, source.data());
+    return *_programs.emplace(std::move(key), std::move(shader)).first->second;
+}
+
+std::vector<PostProcessStack::Entry>::iterator
+PostProcessStack::find(const std::string_view name)
+{
+    return std::ranges::find(_entries, name, [](const Entry& entry) -> std::string_view {
+        return entry.effect.name;
+    });
+}
+
+std::vector<PostProcessStack::Entry>::const_iterator
+PostProcessStack::find(const std::string_view name) const
+{
+    return std::ranges::find(_entries, name, [](const Entry& entry) -> std::string_view {
+        return entry.effect.name;
+    });
+}
+
+} // namespace glesy
@@ -0,0 +1,259 @@
+#include "glesy/ProgramInterface.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+namespace glesy {
+
+namespace {
+
+struct AttributeTypeInfo {
+    GLint components{};
+    GLint locations{1};
+    bool integer{false};
+};
+
+AttributeTypeInfo
+attributeTypeInfo(const GLenum type)
+{
+    switch (type) {
+    case GL_FLOAT:
+        return {1};
+    case GL_FLOAT_VEC2:
+        return {2};
+    case GL_FLOAT_VEC3:
+        return {3};
+    case GL_FLOAT_VEC4:
+        return {4};
+    case GL_FLOAT_MAT2:
+        return {2, 2};
+    case GL_FLOAT_MAT3:
+        return {3, 3};
+    case GL_FLOAT_MAT4:
+        return {4, 4};
+    case GL_FLOAT_MAT2x3:
+        return {3, 2};
+    case GL_FLOAT_MAT2x4:
+        return {4, 2};
+    case GL_FLOAT_MAT3x2:
+        return {2, 3};
+    case GL_FLOAT_MAT3x4:
+        return {4, 3};
+    case GL_FLOAT_MAT4x2:
+        return {2, 4};
+    case GL_FLOAT_MAT4x3:
+        return {3, 4};
+    case GL_INT:
+    case GL_UNSIGNED_INT:
+        return {1, 1, true};
+    case GL_INT_VEC2:
+    case GL_UNSIGNED_INT_VEC2:
+        return {2, 1, true};
+    case GL_INT_VEC3:
+    case GL_UNSIGNED_INT_VEC3:
+        return {3, 1, true};
+    case GL_INT_VEC4:
+    case GL_UNSIGNED_INT_VEC4:
+        return {4, 1, true};
+    default:
+        return {4};
+    }
+}
+
+std::string
+stripArraySuffix(std::string name)
+{
+    if (name.ends_with("[0]")) {
+        name.resize(name.size() - 3);
+    }
+    return name;
+}
+
+template<typename T>
+const T*
+findByName(const std::vector<T>& items, const std::string_view name)
+{
+    const auto it = std::ranges::find(items, name, &T::name);
+    return (it != items.end()) ? &(*it) : nullptr;
+}
+
+} // namespace
+
+ProgramInterface
+ProgramInterface::reflect(const GLuint program)
+{
+    ProgramInterface interface;
+    interface._program = program;
+
+    GLint count{};
+    GLint maxLength{};
+    glGetProgramiv(program, GL_ACTIVE_ATTRIBUTES, &count);
+    glGetProgramiv(program, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &maxLength);
+    std::vector<GLchar> name(std::max(maxLength, 1));
+    for (GLint index = 0; index < count; ++index) {
+        ProgramAttribute attr;
+        GLsizei length{};
+        glGetActiveAttrib(program,
+                          static_cast<GLuint>(index),
+                          static_cast<GLsizei>(name.size()),
+                          &length,
+                          &attr.size,
+                          &attr.type,
+                          name.data());
+        attr.name.assign(name.data(), length);
+        attr.location = glGetAttribLocation(program, attr.name.data());
+        interface._attributes.push_back(std::move(attr));
+    }
+
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+    name.resize(std::max(maxLength, 1));
+    for (GLint index = 0; index < count; ++index) {
+        const auto uniformIndex = static_cast<GLuint>(index);
+        ProgramUniform uniform;
+        GLsizei length{};
+        glGetActiveUniform(program,
+                           uniformIndex,
+                           static_cast<GLsizei>(name.size()),
+                           &length,
+                           &uniform.size,
+                           &uniform.type,
+                           name.data());
+        uniform.name.assign(name.data(), length);
+        glGetActiveUniformsiv(
+            program, 1, &uniformIndex, GL_UNIFORM_BLOCK_INDEX, &uniform.blockIndex);
+        glGetActiveUniformsiv(program, 1, &uniformIndex, GL_UNIFORM_OFFSET, &uniform.blockOffset);
+        if (uniform.blockIndex < 0) {
+            uniform.location = glGetUniformLocation(program, uniform.name.data());
+        }
+        uniform.name = stripArraySuffix(std::move(uniform.name));
+        interface._uniforms.push_back(std::move(uniform));
+    }
+
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCKS, &count);
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &maxLength);
+    name.resize(std::max(maxLength, 1));
+    for (GLint index = 0; index < count; ++index) {
+        ProgramUniformBlock block;
+        block.index = static_cast<GLuint>(index);
+        GLsizei length{};
+        glGetActiveUniformBlockName(
+            program, block.index, static_cast<GLsizei>(name.size()), &length, name.data());
+        block.name.assign(name.data(), length);
+        glGetActiveUniformBlockiv(
+            program, block.index, GL_UNIFORM_BLOCK_DATA_SIZE, &block.dataSize);
+        glGetActiveUniformBlockiv(program, block.index, GL_UNIFORM_BLOCK_BINDING, &block.binding);
+        GLint uniformCount{};
+        glGetActiveUniformBlockiv(
+            program, block.index, GL_UNIFORM_BLOCK_ACTIVE_UNIFORMS, &uniformCount);
+        if (uniformCount > 0) {
+            std::vector<GLint> indices(uniformCount);
+            glGetActiveUniformBlockiv(
+                program, block.index, GL_UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES, indices.data());
+            block.uniforms.assign(indices.begin(), indices.end());
+        }
+        interface._uniformBlocks.push_back(std::move(block));
+    }
+
+    for (std::size_t index = 0; index < interface._uniforms.size(); ++index) {
+        interface._uniformsByName.emplace(interface._uniforms[index].name, index);
+    }
+
+    return interface;
+}
+
+const std::vector<ProgramAttribute>&
+ProgramInterface::attributes() const
+{
+    return _attributes;
+}
+
+const std::vector<ProgramUniform>&
+ProgramInterface::uniforms() const
+{
+    return _uniforms;
+}
+
+const std::vector<ProgramUniformBlock>&
+ProgramInterface::uniformBlocks() const
+{
+    return _uniformBlocks;
+}
+
+const ProgramAttribute*
+ProgramInterface::findAttribute(const std::string_view name) const
+{
+    return findByName(_attributes, name);
+}
+
+const ProgramUniform*
+ProgramInterface::findUniform(const std::string_view name) const
+{
+    if (const auto it = _uniformsByName.find(name); it != _uniformsByName.end()) {
+        return &_uniforms[it->second];
+    }
+    return nullptr;
+}
+
+const ProgramUniformBlock*
+ProgramInterface::findUniformBlock(const std::string_view name) const
+{
+    return findByName(_uniformBlocks, name);
+}
+
+GLint
+ProgramInterface::uniformLocation(const std::string_view name) const
+{
+    if (const auto* uniform = findUniform(name); uniform != nullptr) {
+        return uniform->location;
+    }
+    if (name.contains('[')) {
+        // Array element (e.g. "weights[2]"), locations of elements are not required to be
+        // sequential, so ask the driver
+        return glGetUniformLocation(_program, std::string{name}.data());
+    }
+    return -1;
+}
+
+bool
+ProgramInterface::matches(const VertexFormat& format) const
+{
+    bool matched{true};
+    for (const auto& attr : _attributes) {
+        if (attr.location < 0) {
+            // Built-in inputs (e.g. gl_VertexID) are not fed by vertex buffers
+            continue;
+        }
+        const auto info = attributeTypeInfo(attr.type);
+        const GLint locations = info.locations * attr.size;
+        for (GLint offset = 0; offset < locations; ++offset) {
+            const auto location = static_cast<GLuint>(attr.location + offset);
+            const auto it
+                = std::ranges::find(format.attributes, location, &VertexAttribute::location);
+            if (it == format.attributes.end()) {
+                SPDLOG_ERROR("Attribute <{}> at location <{}> is not provided by vertex format",
+                             attr.name,
+                             location);
+                matched = false;
+                continue;
+            }
+            if (it->integer != info.integer) {
+                SPDLOG_ERROR("Attribute <{}> at location <{}> expects {} data",
+                             attr.name,
+                             location,
+                             info.integer ? "integer" : "floating-point");
+                matched = false;
+            }
+            if (it->components > info.components) {
+                SPDLOG_WARN("Attribute <{}> at location <{}> ignores {} trailing component(s)",
+                            attr.name,
+                            location,
+                            it->components - info.components);
+            }
+        }
+    }
+    return matched;
+}
+
+} // namespace glesy
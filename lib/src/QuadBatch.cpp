@@ -0,0 +1,182 @@
+#include "glesy/QuadBatch.hpp"
+
+#include "glesy/Indices.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace glesy {
+
+namespace {
+
+constexpr std::size_t kVerticesPerQuad{4};
+constexpr std::size_t kIndicesPerQuad{6};
+
+std::vector<GLuint>
+makeQuadIndices(const std::size_t quads)
+{
+    std::vector<GLuint> indices;
+    indices.reserve(quads * kIndicesPerQuad);
+    for (std::size_t quad = 0; quad < quads; ++quad) {
+        const auto base = static_cast<GLuint>(quad * kVerticesPerQuad);
+        for (const GLuint index : {0U, 1U, 2U, 2U, 3U, 0U}) {
+            indices.push_back(base + index);
+        }
+    }
+    return indices;
+}
+
+} // namespace
+
+static_assert(sizeof(QuadBatch::Vertex) == QuadBatch::Layout::kStride);
+
+float
+QuadBatch::Stats::quadsPerDraw() const
+{
+    return (draws > 0) ? static_cast<float>(quads) / static_cast<float>(draws) : 0.0f;
+}
+
+QuadBatch::QuadBatch(const std::size_t maxQuads, const GLsizeiptr streamCapacity)
+    : _maxQuads{maxQuads}
+    , _indices{GL_ELEMENT_ARRAY_BUFFER}
+    , _vertices{GL_ARRAY_BUFFER, streamCapacity}
+{
+    const auto batchSize = static_cast<GLsizeiptr>(maxQuads * kVerticesPerQuad * sizeof(Vertex));
+    if (maxQuads == 0 or batchSize > streamCapacity) {
+        throw std::invalid_argument("Stream capacity is too small for the batch");
+    }
+
+    _vertexArray.setVertexBuffer(_vertices.buffer(), Layout::format());
+    _indexType = selectIndexType(maxQuads * kVerticesPerQuad);
+    const auto indices = packIndices(makeQuadIndices(maxQuads), _indexType);
+    _indices.setData(static_cast<GLsizeiptr>(indices.size()), indices.data());
+    _vertexArray.setIndexBuffer(_indices);
+
+    _pending.reserve(maxQuads * kVerticesPerQuad);
+}
+
+void
+QuadBatch::begin()
+{
+    _stats = {};
+}
+
+void
+QuadBatch::draw(const Shader& shader,
+                const GLuint texture,
+                const glm::mat3& transform,
+                const glm::vec4& uvRect,
+                const glm::u8vec4& color)
+{
+    bind(shader, texture);
+
+    const auto apply = [&transform](const float x, const float y) {
+        const glm::vec3 point = transform * glm::vec3{x, y, 1.0f};
+        return glm::vec2{point.x, point.y};
+    };
+    const glm::vec2 corners[kVerticesPerQuad] = {
+        apply(0.0f, 0.0f),
+        apply(1.0f, 0.0f),
+        apply(1.0f, 1.0f),
+        apply(0.0f, 1.0f),
+    };
+    append(corners, uvRect, color);
+}
+
+void
+QuadBatch::draw(const Shader& shader,
+                const GLuint texture,
+                const glm::vec4& rect,
+                const glm::vec4& uvRect,
+                const glm::u8vec4& color)
+{
+    bind(shader, texture);
+
+    const glm::vec2 corners[kVerticesPerQuad] = {
+        {rect.x, rect.y},
+        {rect.x + rect.z, rect.y},
+        {rect.x + rect.z, rect.y + rect.w},
+        {rect.x, rect.y + rect.w},
+    };
+    append(corners, uvRect, color);
+}
+
+void
+QuadBatch::flush()
+{
+    if (_pending.empty()) {
+        return;
+    }
+
+    const auto size = static_cast<GLsizeiptr>(_pending.size() * sizeof(Vertex));
+    const GLintptr offset = _vertices.write(_pending.data(), size, sizeof(Vertex));
+    const auto quads = _pending.size() / kVerticesPerQuad;
+
+    glUseProgram(_program);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, _texture);
+    _vertexArray.bind();
+    glDrawElementsBaseVertex(GL_TRIANGLES,
+                             static_cast<GLsizei>(quads * kIndicesPerQuad),
+                             _indexType,
+                             nullptr,
+                             static_cast<GLint>(offset / static_cast<GLintptr>(sizeof(Vertex))));
+    VertexArray::unbind();
+
+    _stats.draws++;
+    _stats.quads += quads;
+    _pending.clear();
+}
+
+void
+QuadBatch::end()
+{
+    flush();
+    _vertices.fence();
+    _lastFrameStats = _stats;
+}
+
+const QuadBatch::Stats&
+QuadBatch::stats() const
+{
+    return _stats;
+}
+
+const QuadBatch::Stats&
+QuadBatch::lastFrameStats() const
+{
+    return _lastFrameStats;
+}
+
+void
+QuadBatch::bind(const Shader& shader, const GLuint texture)
+{
+    if (shader.id() == _program and texture == _texture) {
+        return;
+    }
+    flush();
+
+    // Program names are recycled, so validated shaders are remembered by serial
+    if (std::ranges::find(_validShaders, shader.serial()) == _validShaders.end()) {
+        if (not shader.interface().matches(Layout::format())) {
+            throw std::runtime_error("Program inputs don't match quad vertex layout");
+        }
+        _validShaders.push_back(shader.serial());
+    }
+    _program = shader.id();
+    _texture = texture;
+}
+
+void
+QuadBatch::append(const glm::vec2 (&corners)[4], const glm::vec4& uvRect, const glm::u8vec4& color)
+{
+    if (_pending.size() == _maxQuads * kVerticesPerQuad) {
+        flush();
+    }
+    _pending.push_back({corners[0], {uvRect.x, uvRect.y}, color});
+    _pending.push_back({corners[1], {uvRect.z, uvRect.y}, color});
+    _pending.push_back({corners[2], {uvRect.z, uvRect.w}, color});
+    _pending.push_back({corners[3], {uvRect.x, uvRect.w}, color});
+}
+
+} // namespace glesy
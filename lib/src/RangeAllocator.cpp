@@ -0,0 +1,133 @@
+#include "glesy/RangeAllocator.hpp"
+
+#include <iterator>
+#include <stdexcept>
+
+namespace glesy {
+
+RangeAllocator::RangeAllocator(const std::size_t capacity)
+    : _capacity{capacity}
+{
+    reset();
+}
+
+std::size_t
+RangeAllocator::allocate(const std::size_t size)
+{
+    if (size == 0) {
+        return 0;
+    }
+    const auto block = _freeBySize.lower_bound({size, 0});
+    if (block == _freeBySize.end()) {
+        return kInvalidOffset;
+    }
+    const auto [blockSize, offset] = *block;
+    eraseFree(_freeByOffset.find(offset));
+    if (blockSize > size) {
+        insertFree(offset + size, blockSize - size);
+    }
+    _used += size;
+    return offset;
+}
+
+void
+RangeAllocator::free(std::size_t offset, std::size_t size)
+{
+    if (size == 0) {
+        return;
+    }
+    if (offset + size > _capacity or size > _used) {
+        throw std::invalid_argument{"Range doesn't belong to allocator"};
+    }
+    _used -= size;
+
+    auto next = _freeByOffset.lower_bound(offset);
+    if (next != _freeByOffset.begin()) {
+        const auto prev = std::prev(next);
+        if (prev->first + prev->second == offset) {
+            offset = prev->first;
+            size += prev->second;
+            eraseFree(prev);
+        }
+    }
+    if (next != _freeByOffset.end() and offset + size == next->first) {
+        size += next->second;
+        eraseFree(next);
+    }
+    insertFree(offset, size);
+}
+
+void
+RangeAllocator::grow(const std::size_t capacity)
+{
+    if (capacity <= _capacity) {
+        return;
+    }
+    std::size_t offset = _capacity;
+    std::size_t size = capacity - _capacity;
+    if (not _freeByOffset.empty()) {
+        const auto last = std::prev(_freeByOffset.end());
+        if (last->first + last->second == _capacity) {
+            offset = last->first;
+            size += last->second;
+            eraseFree(last);
+        }
+    }
+    insertFree(offset, size);
+    _capacity = capacity;
+}
+
+void
+RangeAllocator::reset()
+{
+    _freeByOffset.clear();
+    _freeBySize.clear();
+    _used = 0;
+    if (_capacity > 0) {
+        insertFree(0, _capacity);
+    }
+}
+
+std::size_t
+RangeAllocator::capacity() const
+{
+    return _capacity;
+}
+
+std::size_t
+RangeAllocator::used() const
+{
+    return _used;
+}
+
+std::size_t
+RangeAllocator::largestFreeBlock() const
+{
+    return _freeBySize.empty() ? 0 : _freeBySize.rbegin()->first;
+}
+
+float
+RangeAllocator::fragmentation() const
+{
+    const std::size_t freeSize = _capacity - _used;
+    if (freeSize == 0) {
+        return 0.0f;
+    }
+    return 1.0f - static_cast<float>(largestFreeBlock()) / static_cast<float>(freeSize);
+}
+
+void
+RangeAllocator::insertFree(const std::size_t offset, const std::size_t size)
+{
+    _freeByOffset.emplace(offset, size);
+    _freeBySize.emplace(size, offset);
+}
+
+void
+RangeAllocator::eraseFree(const std::map<std::size_t, std::size_t>::iterator it)
+{
+    _freeBySize.erase({it->second, it->first});
+    _freeByOffset.erase(it);
+}
+
+} // namespace glesy
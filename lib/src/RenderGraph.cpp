@@ -0,0 +1,323 @@
+#include "glesy/RenderGraph.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+
+namespace glesy {
+
+void
+RenderGraph::PassBuilder::read(const Resource resource)
+{
+    _graph.checkResource(resource);
+    auto& reads = _graph._passes[_pass].reads;
+    if (std::ranges::find(reads, resource) == reads.end()) {
+        reads.push_back(resource);
+    }
+}
+
+void
+RenderGraph::PassBuilder::write(const Resource resource)
+{
+    _graph.checkResource(resource);
+    auto& writes = _graph._passes[_pass].writes;
+    if (std::ranges::find(writes, resource) == writes.end()) {
+        writes.push_back(resource);
+        _graph._resources[resource].writers.push_back(_pass);
+    }
+}
+
+void
+RenderGraph::PassBuilder::sideEffect()
+{
+    _graph._passes[_pass].sideEffect = true;
+}
+
+RenderGraph::PassBuilder::PassBuilder(RenderGraph& graph, const std::size_t pass)
+    : _graph{graph}
+    , _pass{pass}
+{
+}
+
+GLuint
+RenderGraph::PassContext::texture(const Resource resource) const
+{
+    _graph.checkResource(resource);
+    const auto* target = _graph._resources[resource].target;
+    return (target != nullptr) ? target->id() : 0;
+}
+
+void
+RenderGraph::PassContext::bindTexture(const GLuint unit, const Resource resource) const
+{
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_2D, texture(resource));
+}
+
+GLsizei
+RenderGraph::PassContext::width() const
+{
+    return _width;
+}
+
+GLsizei
+RenderGraph::PassContext::height() const
+{
+    return _height;
+}
+
+RenderGraph::PassContext::PassContext(const RenderGraph& graph,
+                                      const GLsizei width,
+                                      const GLsizei height)
+    : _graph{graph}
+    , _width{width}
+    , _height{height}
+{
+}
+
+RenderGraph::RenderGraph(RenderTargetPool& pool)
+    : _pool{pool}
+{
+}
+
+RenderGraph::Resource
+RenderGraph::createTarget(std::string name, const RenderTargetDesc& desc)
+{
+    auto& resource = _resources.emplace_back();
+    resource.name = std::move(name);
+    resource.desc = desc;
+    return static_cast<Resource>(_resources.size() - 1);
+}
+
+RenderGraph::Resource
+RenderGraph::importTarget(std::string name, RenderTarget& target)
+{
+    auto& resource = _resources.emplace_back();
+    resource.name = std::move(name);
+    resource.kind = Kind::Imported;
+    resource.desc = target.desc();
+    resource.target = &target;
+    return static_cast<Resource>(_resources.size() - 1);
+}
+
+RenderGraph::Resource
+RenderGraph::importBackbuffer(const GLsizei width, const GLsizei height)
+{
+    auto& resource = _resources.emplace_back();
+    resource.name = "backbuffer";
+    resource.kind = Kind::Backbuffer;
+    resource.desc = RenderTargetDesc{.width = width, .height = height};
+    return static_cast<Resource>(_resources.size() - 1);
+}
+
+void
+RenderGraph::addPass(std::string name, const SetupFunction& setup, ExecuteFunction execute)
+{
+    auto& pass = _passes.emplace_back();
+    pass.name = std::move(name);
+    pass.execute = std::move(execute);
+    PassBuilder builder{*this, _passes.size() - 1};
+    setup(builder);
+}
+
+void
+RenderGraph::compile()
+{
+    _order.clear();
+    _stats = Stats{.passes = _passes.size()};
+
+    // Kahn's algorithm, ready passes are taken in declaration order
+    std::vector<std::vector<std::size_t>> dependents(_passes.size());
+    std::vector<std::size_t> pending(_passes.size());
+    for (std::size_t pass = 0; pass < _passes.size(); ++pass) {
+        for (const auto dependency : dependencies(pass)) {
+            dependents[dependency].push_back(pass);
+            pending[pass]++;
+        }
+    }
+    std::priority_queue<std::size_t, std::vector<std::size_t>, std::greater<>> ready;
+    for (std::size_t pass = 0; pass < _passes.size(); ++pass) {
+        if (pending[pass] == 0) {
+            ready.push(pass);
+        }
+    }
+    while (not ready.empty()) {
+        const auto pass = ready.top();
+        ready.pop();
+        _order.push_back(pass);
+        for (const auto dependent : dependents[pass]) {
+            if (--pending[dependent] == 0) {
+                ready.push(dependent);
+            }
+        }
+    }
+    if (_order.size() != _passes.size()) {
+        throw std::runtime_error{"Render graph has cyclic pass dependencies"};
+    }
+
+    // Walk backwards from passes producing frame outputs and mark everything they depend on
+    for (auto& pass : _passes) {
+        pass.alive = pass.sideEffect or std::ranges::any_of(pass.writes, [this](const Resource id) {
+                         return _resources[id].kind != Kind::Transient;
+                     });
+    }
+    for (auto it = _order.rbegin(); it != _order.rend(); ++it) {
+        if (not _passes[*it].alive) {
+            continue;
+        }
+        for (const auto dependency : dependencies(*it)) {
+            _passes[dependency].alive = true;
+        }
+    }
+    std::erase_if(_order, [this](const std::size_t pass) {
+        if (not _passes[pass].alive) {
+            SPDLOG_DEBUG("Render graph pass <{}> is culled", _passes[pass].name);
+            return true;
+        }
+        return false;
+    });
+    _stats.culledPasses = _passes.size() - _order.size();
+
+    // Lifetimes as indices into the execution order
+    for (auto& resource : _resources) {
+        resource.used = false;
+    }
+    for (std::size_t step = 0; step < _order.size(); ++step) {
+        const auto& pass = _passes[_order[step]];
+        for (const auto& list : {std::cref(pass.reads), std::cref(pass.writes)}) {
+            for (const auto id : list.get()) {
+                auto& resource = _resources[id];
+                if (not resource.used) {
+                    resource.used = true;
+                    resource.firstUse = step;
+                }
+                resource.lastUse = step;
+            }
+        }
+    }
+    _stats.transientTargets = static_cast<std::size_t>(std::ranges::count_if(
+        _resources, [](const ResourceNode& r) { return r.used and r.kind == Kind::Transient; }));
+}
+
+void
+RenderGraph::execute()
+{
+    std::vector<const RenderTarget*> physical;
+    for (std::size_t step = 0; step < _order.size(); ++step) {
+        auto& pass = _passes[_order[step]];
+
+        // Transient targets are acquired at the first use and returned to the pool after the
+        // last one, so later passes may alias them
+        for (auto& resource : _resources) {
+            if (resource.kind == Kind::Transient and resource.used and resource.firstUse == step) {
+                resource.target = &_pool.acquire(resource.desc);
+                if (std::ranges::find(physical, resource.target) == physical.end()) {
+                    physical.push_back(resource.target);
+                }
+            }
+        }
+
+        GLsizei width{};
+        GLsizei height{};
+        bindOutputs(pass, width, height);
+        if (pass.execute) {
+            pass.execute(PassContext{*this, width, height});
+        }
+
+        for (auto& resource : _resources) {
+            if (resource.kind == Kind::Transient and resource.used and resource.lastUse == step) {
+                _pool.release(*resource.target);
+            }
+        }
+    }
+    _stats.physicalTargets = physical.size();
+    Framebuffer::unbind();
+}
+
+void
+RenderGraph::reset()
+{
+    _resources.clear();
+    _passes.clear();
+    _order.clear();
+}
+
+const RenderGraph::Stats&
+RenderGraph::stats() const
+{
+    return _stats;
+}
+
+void
+RenderGraph::checkResource(const Resource resource) const
+{
+    if (resource >= _resources.size()) {
+        throw std::invalid_argument{"Unknown render graph resource"};
+    }
+}
+
+std::vector<std::size_t>
+RenderGraph::dependencies(const std::size_t pass) const
+{
+    std::vector<std::size_t> result;
+    const auto addWriters = [&](const Resource id, const bool onlyEarlier) {
+        const auto& writers = _resources[id].writers;
+        const bool anyEarlier
+            = std::ranges::any_of(writers, [pass](const std::size_t w) { return w < pass; });
+        for (const auto writer : writers) {
+            // Reads depend on the writes declared before them (or on any write if the resource
+            // is produced by a pass declared later), writes are ordered by declaration
+            if (writer == pass or ((onlyEarlier or anyEarlier) and writer > pass)) {
+                continue;
+            }
+            if (std::ranges::find(result, writer) == result.end()) {
+                result.push_back(writer);
+            }
+        }
+    };
+    for (const auto id : _passes[pass].reads) {
+        addWriters(id, false);
+    }
+    for (const auto id : _passes[pass].writes) {
+        addWriters(id, true);
+    }
+    return result;
+}
+
+void
+RenderGraph::bindOutputs(const PassNode& pass, GLsizei& width, GLsizei& height)
+{
+    std::vector<const RenderTarget*> colors;
+    const RenderTarget* depth{};
+    bool backbuffer{false};
+    for (const auto id : pass.writes) {
+        const auto& resource = _resources[id];
+        width = resource.desc.width;
+        height = resource.desc.height;
+        if (resource.kind == Kind::Backbuffer) {
+            backbuffer = true;
+        } else if (resource.desc.isDepth()) {
+            depth = resource.target;
+        } else {
+            colors.push_back(resource.target);
+        }
+    }
+
+    if (backbuffer) {
+        if (not colors.empty() or depth != nullptr) {
+            SPDLOG_WARN("Render graph pass <{}> writes backbuffer together with targets",
+                        pass.name);
+        }
+        Framebuffer::unbind();
+    } else if (not colors.empty() or depth != nullptr) {
+        _pool.framebuffer(colors, depth).bind();
+    } else {
+        return;
+    }
+    glViewport(0, 0, width, height);
+}
+
+} // namespace glesy
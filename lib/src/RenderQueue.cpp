@@ -0,0 +1,203 @@
+#include "glesy/RenderQueue.hpp"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+namespace glesy {
+
+namespace {
+
+constexpr unsigned kLayerBits{4};
+constexpr unsigned kProgramBits{11};
+constexpr unsigned kMaterialBits{12};
+constexpr unsigned kTextureBits{12};
+constexpr unsigned kDepthBits{24};
+constexpr unsigned kTranslucentShift{64 - kLayerBits - 1};
+
+constexpr unsigned kRadixBits{8};
+constexpr std::size_t kRadixSize{1U << kRadixBits};
+
+std::uint64_t
+fieldBits(const std::uint32_t value, const unsigned bits)
+{
+    return value & ((std::uint64_t{1} << bits) - 1);
+}
+
+std::uint64_t
+quantizeDepth(const float depth)
+{
+    constexpr auto kMaxDepth = static_cast<float>((1U << kDepthBits) - 1);
+    return static_cast<std::uint64_t>(std::clamp(depth, 0.0f, 1.0f) * kMaxDepth);
+}
+
+} // namespace
+
+std::uint64_t
+makeRenderKey(const RenderKeyFields& fields)
+{
+    const std::uint64_t state = (fieldBits(fields.program, kProgramBits)
+                                 << (kMaterialBits + kTextureBits))
+                                | (fieldBits(fields.material, kMaterialBits) << kTextureBits)
+                                | fieldBits(fields.texture, kTextureBits);
+    std::uint64_t key = fieldBits(fields.layer, kLayerBits) << (64 - kLayerBits);
+    if (fields.translucent) {
+        const std::uint64_t depth = ((1U << kDepthBits) - 1) - quantizeDepth(fields.depth);
+        key |= std::uint64_t{1} << kTranslucentShift;
+        key |= depth << (kTranslucentShift - kDepthBits);
+        key |= state;
+    } else {
+        key |= state << kDepthBits;
+        key |= quantizeDepth(fields.depth);
+    }
+    return key;
+}
+
+bool
+isTranslucentKey(const std::uint64_t key)
+{
+    return ((key >> kTranslucentShift) & 1U) != 0;
+}
+
+void
+RenderQueue::reserve(const std::size_t count)
+{
+    _commands.reserve(count);
+    _items.reserve(count);
+}
+
+void
+RenderQueue::push(const RenderCommand& command)
+{
+    _items.push_back({command.key, static_cast<std::uint32_t>(_commands.size())});
+    _commands.push_back(command);
+    _sorted = false;
+}
+
+void
+RenderQueue::append(const std::span<const RenderCommand> commands)
+{
+    _items.reserve(_items.size() + commands.size());
+    for (const auto& command : commands) {
+        _items.push_back({command.key, static_cast<std::uint32_t>(_commands.size())});
+        _commands.push_back(command);
+    }
+    _sorted = _sorted and commands.empty();
+}
+
+void
+RenderQueue::sort()
+{
+    if (_sorted) {
+        return;
+    }
+    _sorted = true;
+    _scratch.resize(_items.size());
+
+    // LSD radix sort, digits equal across all keys are skipped
+    std::uint64_t differing{};
+    for (const auto& item : _items) {
+        differing |= item.key ^ _items.front().key;
+    }
+    for (unsigned shift = 0; shift < 64; shift += kRadixBits) {
+        if (((differing >> shift) & (kRadixSize - 1)) == 0) {
+            continue;
+        }
+        std::array<std::size_t, kRadixSize> offsets{};
+        for (const auto& item : _items) {
+            offsets[(item.key >> shift) & (kRadixSize - 1)]++;
+        }
+        std::size_t sum{};
+        for (auto& offset : offsets) {
+            sum += std::exchange(offset, sum);
+        }
+        for (const auto& item : _items) {
+            _scratch[offsets[(item.key >> shift) & (kRadixSize - 1)]++] = item;
+        }
+        _items.swap(_scratch);
+    }
+}
+
+void
+RenderQueue::execute(StateCache& state)
+{
+    sort();
+
+    const auto changesBefore = state.stats().changes;
+    for (const auto& item : _items) {
+        const auto& command = _commands[item.index];
+        if (command.indexCount <= 0 or command.instanceCount <= 0) {
+            // Nothing to draw, don't pay for state changes either
+            continue;
+        }
+        const bool translucent = isTranslucentKey(command.key);
+        state.setBlend(translucent);
+        state.setDepthWrite(not translucent);
+        if (translucent) {
+            state.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        }
+        state.useProgram(command.program);
+        state.bindVertexArray(command.vertexArray);
+        if (command.texture != 0) {
+            state.bindTexture(0, GL_TEXTURE_2D, command.texture);
+        }
+        if (command.materialBuffer != 0) {
+            state.bindUniformBuffer(kMaterialBlockBinding,
+                                    command.materialBuffer,
+                                    command.materialOffset,
+                                    command.materialSize);
+        }
+        if (command.modelLocation >= 0) {
+            glUniformMatrix4fv(command.modelLocation, 1, GL_FALSE, &command.model[0][0]);
+        }
+
+        const auto* offset = reinterpret_cast<const void*>(command.indexOffset);
+        if (command.instanceCount > 1) {
+            glDrawElementsInstancedBaseVertex(command.primitive,
+                                              command.indexCount,
+                                              command.indexType,
+                                              offset,
+                                              command.instanceCount,
+                                              command.baseVertex);
+        } else {
+            glDrawElementsBaseVertex(command.primitive,
+                                     command.indexCount,
+                                     command.indexType,
+                                     offset,
+                                     command.baseVertex);
+        }
+        _stats.drawCalls++;
+    }
+
+    _stats.commands += _commands.size();
+    _stats.stateChanges += state.stats().changes - changesBefore;
+}
+
+void
+RenderQueue::clear()
+{
+    _commands.clear();
+    _items.clear();
+    _sorted = true;
+    _stats = {};
+}
+
+std::span<const RenderCommand>
+RenderQueue::commands() const
+{
+    return _commands;
+}
+
+std::size_t
+RenderQueue::size() const
+{
+    return _commands.size();
+}
+
+const RenderQueue::Stats&
+RenderQueue::stats() const
+{
+    return _stats;
+}
+
+} // namespace glesy
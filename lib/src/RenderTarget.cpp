@@ -0,0 +1,232 @@
+#include "glesy/RenderTarget.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <utility>
+
+namespace glesy {
+
+namespace {
+
+struct FormatInfo {
+    GLenum format{};
+    GLenum type{};
+    std::size_t bytesPerPixel{};
+};
+
+FormatInfo
+formatInfo(const GLenum internalFormat)
+{
+    switch (internalFormat) {
+    case GL_R8:
+        return {GL_RED, GL_UNSIGNED_BYTE, 1};
+    case GL_RG8:
+        return {GL_RG, GL_UNSIGNED_BYTE, 2};
+    case GL_RGB8:
+        return {GL_RGB, GL_UNSIGNED_BYTE, 4};
+    case GL_RGBA8:
+    case GL_SRGB8_ALPHA8:
+        return {GL_RGBA, GL_UNSIGNED_BYTE, 4};
+    case GL_RGB10_A2:
+        return {GL_RGBA, GL_UNSIGNED_INT_2_10_10_10_REV, 4};
+    case GL_R11F_G11F_B10F:
+        return {GL_RGB, GL_FLOAT, 4};
+    case GL_R16F:
+        return {GL_RED, GL_HALF_FLOAT, 2};
+    case GL_RG16F:
+        return {GL_RG, GL_HALF_FLOAT, 4};
+    case GL_RGBA16F:
+        return {GL_RGBA, GL_HALF_FLOAT, 8};
+    case GL_R32F:
+        return {GL_RED, GL_FLOAT, 4};
+    case GL_RG32F:
+        return {GL_RG, GL_FLOAT, 8};
+    case GL_RGBA32F:
+        return {GL_RGBA, GL_FLOAT, 16};
+    case GL_DEPTH_COMPONENT16:
+        return {GL_DEPTH_COMPONENT, GL_UNSIGNED_SHORT, 2};
+    case GL_DEPTH_COMPONENT24:
+        return {GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, 4};
+    case GL_DEPTH_COMPONENT32F:
+        return {GL_DEPTH_COMPONENT, GL_FLOAT, 4};
+    case GL_DEPTH24_STENCIL8:
+        return {GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, 4};
+    case GL_DEPTH32F_STENCIL8:
+        return {GL_DEPTH_STENCIL, GL_FLOAT_32_UNSIGNED_INT_24_8_REV, 8};
+    default:
+        throw std::invalid_argument("Unsupported render target format");
+    }
+}
+
+} // namespace
+
+bool
+RenderTargetDesc::isDepth() const
+{
+    const auto format = formatInfo(internalFormat).format;
+    return format == GL_DEPTH_COMPONENT or format == GL_DEPTH_STENCIL;
+}
+
+bool
+RenderTargetDesc::hasStencil() const
+{
+    return formatInfo(internalFormat).format == GL_DEPTH_STENCIL;
+}
+
+std::size_t
+RenderTargetDesc::byteSize() const
+{
+    return static_cast<std::size_t>(width) * static_cast<std::size_t>(height)
+           * formatInfo(internalFormat).bytesPerPixel;
+}
+
+RenderTarget::RenderTarget(const RenderTargetDesc& desc)
+    : _desc{desc}
+{
+    const auto info = formatInfo(desc.internalFormat);
+    if (glGenTextures(1, &_id); _id == 0) {
+        throw std::runtime_error("Failed to create render target");
+    }
+    glBindTexture(GL_TEXTURE_2D, _id);
+    glTexImage2D(GL_TEXTURE_2D,
+                 0,
+                 static_cast<GLint>(desc.internalFormat),
+                 desc.width,
+                 desc.height,
+                 0,
+                 info.format,
+                 info.type,
+                 nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+RenderTarget::RenderTarget(RenderTarget&& other) noexcept
+    : _id{std::exchange(other._id, 0)}
+    , _desc{other._desc}
+{
+}
+
+RenderTarget&
+RenderTarget::operator=(RenderTarget&& other) noexcept
+{
+    if (this != &other) {
+        glDeleteTextures(1, &_id);
+        _id = std::exchange(other._id, 0);
+        _desc = other._desc;
+    }
+    return *this;
+}
+
+RenderTarget::~RenderTarget()
+{
+    glDeleteTextures(1, &_id);
+}
+
+GLuint
+RenderTarget::id() const
+{
+    return _id;
+}
+
+const RenderTargetDesc&
+RenderTarget::desc() const
+{
+    return _desc;
+}
+
+Framebuffer::Framebuffer()
+{
+    if (glGenFramebuffers(1, &_id); _id == 0) {
+        throw std::runtime_error("Failed to create framebuffer");
+    }
+}
+
+Framebuffer::Framebuffer(Framebuffer&& other) noexcept
+    : _id{std::exchange(other._id, 0)}
+{
+}
+
+Framebuffer&
+Framebuffer::operator=(Framebuffer&& other) noexcept
+{
+    if (this != &other) {
+        glDeleteFramebuffers(1, &_id);
+        _id = std::exchange(other._id, 0);
+    }
+    return *this;
+}
+
+Framebuffer::~Framebuffer()
+{
+    glDeleteFramebuffers(1, &_id);
+}
+
+GLuint
+Framebuffer::id() const
+{
+    return _id;
+}
+
+void
+Framebuffer::bind() const
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, _id);
+}
+
+void
+Framebuffer::unbind()
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void
+Framebuffer::attach(const GLuint colorIndex, const RenderTarget& target)
+{
+    GLenum attachment = GL_COLOR_ATTACHMENT0 + colorIndex;
+    if (target.desc().isDepth()) {
+        attachment = target.desc().hasStencil() ? GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT;
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, _id);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D, target.id(), 0);
+}
+
+void
+Framebuffer::setDrawBuffers(const GLsizei count)
+{
+    static constexpr std::array<GLenum, 8> kBuffers{GL_COLOR_ATTACHMENT0,
+                                                    GL_COLOR_ATTACHMENT1,
+                                                    GL_COLOR_ATTACHMENT2,
+                                                    GL_COLOR_ATTACHMENT3,
+                                                    GL_COLOR_ATTACHMENT4,
+                                                    GL_COLOR_ATTACHMENT5,
+                                                    GL_COLOR_ATTACHMENT6,
+                                                    GL_COLOR_ATTACHMENT7};
+    glBindFramebuffer(GL_FRAMEBUFFER, _id);
+    if (count == 0) {
+        glDrawBuffer(GL_NONE);
+        glReadBuffer(GL_NONE);
+    } else {
+        glDrawBuffers(std::min<GLsizei>(count, kBuffers.size()), kBuffers.data());
+    }
+}
+
+bool
+Framebuffer::complete() const
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, _id);
+    const GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        SPDLOG_ERROR("Framebuffer is incomplete: status <{:#x}>", status);
+        return false;
+    }
+    return true;
+}
+
+} // namespace glesy
@@ -0,0 +1,130 @@
+#include "glesy/RenderTargetPool.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace glesy {
+
+RenderTargetPool::RenderTargetPool(const std::size_t budget)
+    : _budget{budget}
+{
+}
+
+RenderTarget&
+RenderTargetPool::acquire(const RenderTargetDesc& desc)
+{
+    for (auto& entry : _entries) {
+        if (not entry.inUse and entry.target->desc() == desc) {
+            entry.inUse = true;
+            entry.lastUsedFrame = _frame;
+            return *entry.target;
+        }
+    }
+
+    const std::size_t size = desc.byteSize();
+    if (_budget > 0) {
+        // Evict idle targets, the least recently used first
+        while (_allocated + size > _budget) {
+            std::size_t victim = _entries.size();
+            for (std::size_t index = 0; index < _entries.size(); ++index) {
+                if (not _entries[index].inUse
+                    and (victim == _entries.size()
+                         or _entries[index].lastUsedFrame < _entries[victim].lastUsedFrame)) {
+                    victim = index;
+                }
+            }
+            if (victim == _entries.size()) {
+                SPDLOG_WARN("Render target pool exceeds budget: {} of {} bytes",
+                            _allocated + size,
+                            _budget);
+                break;
+            }
+            evict(victim);
+        }
+    }
+
+    _entries.push_back(Entry{.target = std::make_unique<RenderTarget>(desc),
+                             .inUse = true,
+                             .lastUsedFrame = _frame});
+    _allocated += size;
+    return *_entries.back().target;
+}
+
+void
+RenderTargetPool::release(const RenderTarget& target)
+{
+    const auto it = std::ranges::find_if(
+        _entries, [&target](const Entry& entry) { return entry.target.get() == &target; });
+    if (it == _entries.end()) {
+        throw std::invalid_argument{"Render target doesn't belong to the pool"};
+    }
+    it->inUse = false;
+}
+
+Framebuffer&
+RenderTargetPool::framebuffer(const std::span<const RenderTarget* const> colors,
+                              const RenderTarget* depth)
+{
+    std::vector<GLuint> key;
+    key.reserve(colors.size() + 1);
+    for (const auto* color : colors) {
+        key.push_back(color->id());
+    }
+    key.push_back((depth != nullptr) ? depth->id() : 0);
+
+    if (const auto it = _framebuffers.find(key); it != _framebuffers.end()) {
+        return it->second;
+    }
+
+    Framebuffer framebuffer;
+    for (GLuint index = 0; index < colors.size(); ++index) {
+        framebuffer.attach(index, *colors[index]);
+    }
+    if (depth != nullptr) {
+        framebuffer.attach(0, *depth);
+    }
+    framebuffer.setDrawBuffers(static_cast<GLsizei>(colors.size()));
+    if (not framebuffer.complete()) {
+        throw std::runtime_error{"Render graph pass has incomplete framebuffer"};
+    }
+    return _framebuffers.emplace(std::move(key), std::move(framebuffer)).first->second;
+}
+
+void
+RenderTargetPool::endFrame(const std::size_t maxIdleFrames)
+{
+    for (std::size_t index = _entries.size(); index > 0; --index) {
+        const auto& entry = _entries[index - 1];
+        if (not entry.inUse and _frame - entry.lastUsedFrame > maxIdleFrames) {
+            evict(index - 1);
+        }
+    }
+    _frame++;
+}
+
+std::size_t
+RenderTargetPool::allocatedBytes() const
+{
+    return _allocated;
+}
+
+std::size_t
+RenderTargetPool::targetCount() const
+{
+    return _entries.size();
+}
+
+void
+RenderTargetPool::evict(const std::size_t index)
+{
+    const GLuint id = _entries[index].target->id();
+    std::erase_if(_framebuffers, [id](const auto& item) {
+        return std::ranges::find(item.first, id) != item.first.end();
+    });
+    _allocated -= _entries[index].target->desc().byteSize();
+    _entries.erase(_entries.begin() + static_cast<std::ptrdiff_t>(index));
+}
+
+} // namespace glesy
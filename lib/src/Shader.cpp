@@ -2,15 +2,31 @@
 
 #include "glesy/Utils.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <stdexcept>
+#include <utility>
 
 namespace glesy {
 
+namespace {
+
+std::uint64_t
+nextSerial()
+{
+    static std::atomic<std::uint64_t> serial{};
+    return serial.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+} // namespace
+
 Shader::Shader(const GLchar* vertexShaderSrc, const GLchar* fragShaderSrc)
+    : _serial{nextSerial()}
 {
     if (_program = loadProgram(vertexShaderSrc, fragShaderSrc); _program == 0) {
         throw std::runtime_error("Failed to load shaders");
     }
+    _interface = ProgramInterface::reflect(_program);
 }
 
 Shader::~Shader()
@@ -24,6 +40,48 @@ Shader::id() const
     return _program;
 }
 
+std::uint64_t
+Shader::serial() const
+{
+    return _serial;
+}
+
+const ProgramInterface&
+Shader::interface() const
+{
+    return _interface;
+}
+
+GLuint
+Shader::vertexArray(const Buffer& vertexBuffer,
+                    const Buffer* indexBuffer,
+                    const VertexFormat& format) const
+{
+    const std::uint64_t vertexSerial = vertexBuffer.serial();
+    const std::uint64_t indexSerial = (indexBuffer != nullptr) ? indexBuffer->serial() : 0;
+    const auto it = std::ranges::find_if(_vertexArrays, [&](const CachedVertexArray& cached) {
+        return cached.vertexBuffer == vertexSerial and cached.indexBuffer == indexSerial
+               and cached.format == format;
+    });
+    if (it != _vertexArrays.end()) {
+        return it->vertexArray.id();
+    }
+
+    if (not _interface.matches(format)) {
+        throw std::runtime_error("Vertex format doesn't match program inputs");
+    }
+
+    VertexArray vertexArray;
+    vertexArray.setVertexBuffer(vertexBuffer, format);
+    if (indexBuffer != nullptr) {
+        vertexArray.setIndexBuffer(*indexBuffer);
+    }
+
+    const GLuint id = vertexArray.id();
+    _vertexArrays.push_back({vertexSerial, indexSerial, format, std::move(vertexArray)});
+    return id;
+}
+
 void
 Shader::use() const
 {
@@ -33,19 +91,19 @@ Shader::use() const
 void
 Shader::setBool(const std::string& name, const bool value) const
 {
-    glUniform1i(glGetUniformLocation(_program, name.data()), static_cast<int>(value));
+    glUniform1i(_interface.uniformLocation(name), static_cast<int>(value));
 }
 
 void
 Shader::setInt(const std::string& name, const int value) const
 {
-    glUniform1i(glGetUniformLocation(_program, name.data()), value);
+    glUniform1i(_interface.uniformLocation(name), value);
 }
 
 void
 Shader::setFloat(const std::string& name, const float value) const
 {
-    glUniform1f(glGetUniformLocation(_program, name.data()), value);
+    glUniform1f(_interface.uniformLocation(name), value);
 }
 
 } // namespace glesy
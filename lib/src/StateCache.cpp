@@ -0,0 +1,159 @@
+#include "glesy/StateCache.hpp"
+
+namespace glesy {
+
+StateCache::StateCache()
+{
+    invalidate();
+}
+
+void
+StateCache::useProgram(const GLuint program)
+{
+    if (update(not _programKnown or _program != program)) {
+        glUseProgram(program);
+        _program = program;
+        _programKnown = true;
+    }
+}
+
+void
+StateCache::bindVertexArray(const GLuint vertexArray)
+{
+    if (update(not _vertexArrayKnown or _vertexArray != vertexArray)) {
+        glBindVertexArray(vertexArray);
+        _vertexArray = vertexArray;
+        _vertexArrayKnown = true;
+    }
+}
+
+void
+StateCache::bindTexture(const GLuint unit, const GLenum target, const GLuint texture)
+{
+    auto& binding = _textures.at(unit);
+    if (not update(not binding.known or binding.target != target or binding.texture != texture)) {
+        return;
+    }
+    if (not _activeUnitKnown or _activeUnit != unit) {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        _activeUnit = unit;
+        _activeUnitKnown = true;
+    }
+    glBindTexture(target, texture);
+    binding = {.target = target, .texture = texture, .known = true};
+}
+
+void
+StateCache::bindUniformBuffer(const GLuint binding,
+                              const GLuint buffer,
+                              const GLintptr offset,
+                              const GLsizeiptr size)
+{
+    auto& range = _uniformBuffers.at(binding);
+    const bool changed = not range.known or range.buffer != buffer or range.offset != offset
+                         or range.size != size;
+    if (not update(changed)) {
+        return;
+    }
+    if (buffer == 0 or size <= 0) {
+        glBindBufferBase(GL_UNIFORM_BUFFER, binding, buffer);
+    } else {
+        glBindBufferRange(GL_UNIFORM_BUFFER, binding, buffer, offset, size);
+    }
+    range = {.buffer = buffer, .offset = offset, .size = size, .known = true};
+}
+
+void
+StateCache::setBlend(const bool enabled)
+{
+    setCapability(_blend, GL_BLEND, enabled);
+}
+
+void
+StateCache::setBlendFunc(const GLenum source, const GLenum destination)
+{
+    const bool changed
+        = not _blendFuncKnown or _blendSource != source or _blendDestination != destination;
+    if (update(changed)) {
+        glBlendFunc(source, destination);
+        _blendSource = source;
+        _blendDestination = destination;
+        _blendFuncKnown = true;
+    }
+}
+
+void
+StateCache::setDepthTest(const bool enabled)
+{
+    setCapability(_depthTest, GL_DEPTH_TEST, enabled);
+}
+
+void
+StateCache::setDepthWrite(const bool enabled)
+{
+    const Flag flag = enabled ? Flag::Enabled : Flag::Disabled;
+    if (update(_depthWrite != flag)) {
+        glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+        _depthWrite = flag;
+    }
+}
+
+void
+StateCache::setCullFace(const bool enabled)
+{
+    setCapability(_cullFace, GL_CULL_FACE, enabled);
+}
+
+void
+StateCache::invalidate()
+{
+    _programKnown = false;
+    _vertexArrayKnown = false;
+    _activeUnitKnown = false;
+    _textures.fill({});
+    _uniformBuffers.fill({});
+    _blendFuncKnown = false;
+    _blend = Flag::Unknown;
+    _depthTest = Flag::Unknown;
+    _depthWrite = Flag::Unknown;
+    _cullFace = Flag::Unknown;
+}
+
+const StateCache::Stats&
+StateCache::stats() const
+{
+    return _stats;
+}
+
+void
+StateCache::resetStats()
+{
+    _stats = {};
+}
+
+bool
+StateCache::update(const bool changed)
+{
+    if (changed) {
+        _stats.changes++;
+    } else {
+        _stats.skipped++;
+    }
+    return changed;
+}
+
+void
+StateCache::setCapability(Flag& flag, const GLenum capability, const bool enabled)
+{
+    const Flag value = enabled ? Flag::Enabled : Flag::Disabled;
+    if (update(flag != value)) {
+        if (enabled) {
+            glEnable(capability);
+        } else {
+            glDisable(capability);
+        }
+        flag = value;
+    }
+}
+
+} // namespace glesy
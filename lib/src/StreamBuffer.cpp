@@ -0,0 +1,229 @@
+#include "glesy/StreamBuffer.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <cstring>
+#include <stdexcept>
+
+namespace glesy {
+
+namespace {
+
+/** Mapping and updates go through dedicated target to keep VAO element binding intact */
+constexpr GLenum kStagingTarget{GL_COPY_WRITE_BUFFER};
+constexpr GLuint64 kFenceTimeout{1'000'000'000}; // 1 second
+
+GLintptr
+alignUp(const GLintptr value, const GLsizeiptr alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+/**
+ * Check whether two regions of the ring overlap (regions might wrap around the end)
+ */
+bool
+overlaps(const GLintptr a,
+         const GLsizeiptr aSize,
+         const GLintptr b,
+         const GLsizeiptr bSize,
+         const GLsizeiptr capacity)
+{
+    if (aSize <= 0 or bSize <= 0) {
+        return false;
+    }
+    const auto distance = [capacity](const GLintptr from, const GLintptr to) {
+        return ((to - from) % capacity + capacity) % capacity;
+    };
+    return distance(a, b) < aSize or distance(b, a) < bSize;
+}
+
+} // namespace
+
+StreamBuffer::StreamBuffer(const GLenum target, const GLsizeiptr capacity, const Strategy strategy)
+    : _buffer{target}
+    , _capacity{capacity}
+    , _strategy{strategy}
+{
+    if (capacity <= 0) {
+        throw std::invalid_argument("Invalid stream buffer capacity");
+    }
+    _buffer.setData(_capacity, nullptr, GL_STREAM_DRAW);
+}
+
+StreamBuffer::~StreamBuffer()
+{
+    for (const auto& fence : _fences) {
+        glDeleteSync(fence.sync);
+    }
+}
+
+const Buffer&
+StreamBuffer::buffer() const
+{
+    return _buffer;
+}
+
+GLsizeiptr
+StreamBuffer::capacity() const
+{
+    return _capacity;
+}
+
+StreamBuffer::Strategy
+StreamBuffer::strategy() const
+{
+    return _strategy;
+}
+
+std::size_t
+StreamBuffer::stalls() const
+{
+    return _stalls;
+}
+
+StreamBuffer::Region
+StreamBuffer::map(const GLsizeiptr size, const GLsizeiptr alignment)
+{
+    if (_mapped) {
+        throw std::logic_error("Stream buffer is already mapped");
+    }
+
+    const GLintptr offset = allocate(size, alignment);
+    glBindBuffer(kStagingTarget, _buffer.id());
+    void* data = glMapBufferRange(kStagingTarget,
+                                  offset,
+                                  size,
+                                  GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT
+                                      | GL_MAP_UNSYNCHRONIZED_BIT);
+    if (data == nullptr) {
+        glBindBuffer(kStagingTarget, 0);
+        throw std::runtime_error("Failed to map stream buffer");
+    }
+    _mapped = true;
+    return {data, offset, size};
+}
+
+void
+StreamBuffer::unmap()
+{
+    if (not _mapped) {
+        return;
+    }
+    glBindBuffer(kStagingTarget, _buffer.id());
+    if (glUnmapBuffer(kStagingTarget) != GL_TRUE) {
+        SPDLOG_WARN("Stream buffer storage was corrupted while mapped");
+    }
+    glBindBuffer(kStagingTarget, 0);
+    _mapped = false;
+}
+
+GLintptr
+StreamBuffer::write(const void* data, const GLsizeiptr size, const GLsizeiptr alignment)
+{
+    if (_strategy == Strategy::Orphaning) {
+        const GLintptr offset = allocate(size, alignment);
+        glBindBuffer(kStagingTarget, _buffer.id());
+        glBufferSubData(kStagingTarget, offset, size, data);
+        glBindBuffer(kStagingTarget, 0);
+        return offset;
+    }
+
+    const auto region = map(size, alignment);
+    std::memcpy(region.data, data, static_cast<std::size_t>(size));
+    unmap();
+    return region.offset;
+}
+
+void
+StreamBuffer::fence()
+{
+    if (_pendingSize == 0 or _strategy == Strategy::Orphaning) {
+        _pendingSize = 0;
+        _pendingBegin = _head;
+        return;
+    }
+
+    if (GLsync sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0); sync != nullptr) {
+        _fences.push_back({sync, _pendingBegin, _pendingSize});
+    } else {
+        SPDLOG_ERROR("Unable to create fence: error<{}>", glGetError());
+        glFinish();
+    }
+    _pendingBegin = _head;
+    _pendingSize = 0;
+}
+
+GLintptr
+StreamBuffer::allocate(const GLsizeiptr size, const GLsizeiptr alignment)
+{
+    if (size <= 0 or size > _capacity) {
+        throw std::length_error("Invalid stream buffer region size");
+    }
+
+    GLintptr offset = alignUp(_head, alignment);
+    if (offset + size > _capacity) {
+        if (_strategy == Strategy::Orphaning) {
+            orphan();
+        }
+        offset = 0;
+    }
+
+    if (_strategy == Strategy::Unsynchronized) {
+        if (overlaps(offset, size, _pendingBegin, _pendingSize, _capacity)) {
+            // Wrapped onto own unfenced writes (more data per frame than ring capacity)
+            fence();
+        }
+        waitFor(offset, size);
+    }
+
+    const GLintptr end = offset + size;
+    _pendingSize += (end >= _head) ? (end - _head) : (_capacity - _head + end);
+    _head = end;
+    return offset;
+}
+
+void
+StreamBuffer::waitFor(const GLintptr begin, const GLsizeiptr size)
+{
+    // Fences are signaled in order, so waiting on the newest overlapping fence retires
+    // all older ones as well
+    auto last = _fences.end();
+    for (auto it = _fences.begin(); it != _fences.end(); ++it) {
+        if (overlaps(begin, size, it->begin, it->size, _capacity)) {
+            last = it;
+        }
+    }
+    if (last == _fences.end()) {
+        return;
+    }
+
+    GLenum status = glClientWaitSync(last->sync, 0, 0);
+    if (status == GL_TIMEOUT_EXPIRED) {
+        ++_stalls;
+        do {
+            status = glClientWaitSync(last->sync, GL_SYNC_FLUSH_COMMANDS_BIT, kFenceTimeout);
+        }
+        while (status == GL_TIMEOUT_EXPIRED);
+    }
+    if (status == GL_WAIT_FAILED) {
+        SPDLOG_ERROR("Unable to wait for fence: error<{}>", glGetError());
+    }
+
+    const auto retired = std::next(last);
+    for (auto it = _fences.begin(); it != retired; ++it) {
+        glDeleteSync(it->sync);
+    }
+    _fences.erase(_fences.begin(), retired);
+}
+
+void
+StreamBuffer::orphan()
+{
+    _buffer.setData(_capacity, nullptr, GL_STREAM_DRAW);
+    _head = 0;
+    _pendingBegin = 0;
+    _pendingSize = 0;
+}
+
+} // namespace glesy
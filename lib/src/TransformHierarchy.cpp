@@ -0,0 +1,348 @@
+#include "glesy/TransformHierarchy.hpp"
+#include "glesy/Parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) and defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace glesy {
+
+namespace {
+
+/**
+ * Multiply column-major matrices, output must not alias inputs
+ */
+void
+multiply(const glm::mat4& a, const glm::mat4& b, glm::mat4& output)
+{
+#if defined(__SSE2__)
+    const __m128 a0 = _mm_loadu_ps(&a[0][0]);
+    const __m128 a1 = _mm_loadu_ps(&a[1][0]);
+    const __m128 a2 = _mm_loadu_ps(&a[2][0]);
+    const __m128 a3 = _mm_loadu_ps(&a[3][0]);
+    for (int column = 0; column < 4; ++column) {
+        const __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a0, _mm_set1_ps(b[column][0])),
+                                               _mm_mul_ps(a1, _mm_set1_ps(b[column][1]))),
+                                    _mm_add_ps(_mm_mul_ps(a2, _mm_set1_ps(b[column][2])),
+                                               _mm_mul_ps(a3, _mm_set1_ps(b[column][3]))));
+        _mm_storeu_ps(&output[column][0], r);
+    }
+#elif defined(__ARM_NEON) and defined(__aarch64__)
+    const float32x4_t a0 = vld1q_f32(&a[0][0]);
+    const float32x4_t a1 = vld1q_f32(&a[1][0]);
+    const float32x4_t a2 = vld1q_f32(&a[2][0]);
+    const float32x4_t a3 = vld1q_f32(&a[3][0]);
+    for (int column = 0; column < 4; ++column) {
+        const float32x4_t bc = vld1q_f32(&b[column][0]);
+        float32x4_t r = vmulq_laneq_f32(a0, bc, 0);
+        r = vfmaq_laneq_f32(r, a1, bc, 1);
+        r = vfmaq_laneq_f32(r, a2, bc, 2);
+        r = vfmaq_laneq_f32(r, a3, bc, 3);
+        vst1q_f32(&output[column][0], r);
+    }
+#else
+    output = a * b;
+#endif
+}
+
+} // namespace
+
+TransformHierarchy::Node
+TransformHierarchy::create(const Node parent, const glm::mat4& local)
+{
+    if (parent != kInvalidNode and not contains(parent)) {
+        throw std::invalid_argument{"Invalid parent transform node"};
+    }
+
+    Node node{};
+    if (_freeNodes.empty()) {
+        node = static_cast<Node>(_slots.size());
+        _slots.push_back(kNoSlot);
+        _parents.push_back(kInvalidNode);
+    } else {
+        node = _freeNodes.back();
+        _freeNodes.pop_back();
+    }
+    _parents[node] = parent;
+    appendSlot(node, local);
+    return node;
+}
+
+void
+TransformHierarchy::destroy(const Node node)
+{
+    if (not contains(node)) {
+        throw std::invalid_argument{"Invalid transform node"};
+    }
+    if (not _sorted) {
+        rebuild();
+    }
+
+    // Descendants follow the node in depth order, so one forward pass finds the whole subtree
+    const std::uint32_t first = slot(node);
+    std::vector<std::uint8_t> removed(_nodes.size() - first);
+    removed[0] = 1;
+    for (std::size_t index = first + 1; index < _nodes.size(); ++index) {
+        const auto parentSlot = _parentSlots[index];
+        if (parentSlot != kNoSlot and parentSlot >= first and removed[parentSlot - first] != 0) {
+            removed[index - first] = 1;
+        }
+    }
+    for (std::size_t index = first; index < _nodes.size(); ++index) {
+        if (removed[index - first] != 0) {
+            const Node removedNode = _nodes[index];
+            _slots[removedNode] = kNoSlot;
+            _parents[removedNode] = kInvalidNode;
+            _freeNodes.push_back(removedNode);
+        }
+    }
+    _sorted = false;
+    rebuild();
+}
+
+void
+TransformHierarchy::setParent(const Node node, const Node parent)
+{
+    if (not contains(node) or (parent != kInvalidNode and not contains(parent))) {
+        throw std::invalid_argument{"Invalid transform node"};
+    }
+    for (Node ancestor = parent; ancestor != kInvalidNode; ancestor = _parents[ancestor]) {
+        if (ancestor == node) {
+            throw std::invalid_argument{"Transform node can't be attached to own subtree"};
+        }
+    }
+    if (_parents[node] == parent) {
+        return;
+    }
+    _parents[node] = parent;
+    _dirty[slot(node)] = 1;
+    _changed = true;
+    _sorted = false;
+}
+
+TransformHierarchy::Node
+TransformHierarchy::parent(const Node node) const
+{
+    if (not contains(node)) {
+        throw std::invalid_argument{"Invalid transform node"};
+    }
+    return _parents[node];
+}
+
+void
+TransformHierarchy::setLocal(const Node node, const glm::mat4& local)
+{
+    const auto index = slot(node);
+    _locals[index] = local;
+    _dirty[index] = 1;
+    _changed = true;
+}
+
+const glm::mat4&
+TransformHierarchy::local(const Node node) const
+{
+    return _locals[slot(node)];
+}
+
+const glm::mat4&
+TransformHierarchy::world(const Node node) const
+{
+    return _worlds[slot(node)];
+}
+
+bool
+TransformHierarchy::contains(const Node node) const
+{
+    return node < _slots.size() and _slots[node] != kNoSlot;
+}
+
+std::size_t
+TransformHierarchy::update(const std::size_t grain)
+{
+    if (not _sorted) {
+        rebuild();
+    }
+    if (not _changed) {
+        return 0;
+    }
+
+    // Parents are finished in the previous level, so their dirty flags are final when children
+    // of the level read them
+    std::atomic<std::size_t> updated{};
+    for (std::size_t level = 0; level + 1 < _levels.size(); ++level) {
+        const std::size_t levelBegin = _levels[level];
+        const std::size_t levelSize = _levels[level + 1] - levelBegin;
+        parallelFor(levelSize, grain, [&](const std::size_t begin, const std::size_t end) {
+            std::size_t count{};
+            for (std::size_t index = levelBegin + begin; index < levelBegin + end; ++index) {
+                const auto parentSlot = _parentSlots[index];
+                if (parentSlot == kNoSlot) {
+                    if (_dirty[index] != 0) {
+                        _worlds[index] = _locals[index];
+                        count++;
+                    }
+                } else if (_dirty[index] != 0 or _dirty[parentSlot] != 0) {
+                    multiply(_worlds[parentSlot], _locals[index], _worlds[index]);
+                    _dirty[index] = 1;
+                    count++;
+                }
+            }
+            updated.fetch_add(count, std::memory_order_relaxed);
+        });
+    }
+    std::ranges::fill(_dirty, std::uint8_t{0});
+    _changed = false;
+    return updated.load();
+}
+
+std::size_t
+TransformHierarchy::size() const
+{
+    return _nodes.size();
+}
+
+std::span<const glm::mat4>
+TransformHierarchy::worldMatrices() const
+{
+    return _worlds;
+}
+
+std::span<const TransformHierarchy::Node>
+TransformHierarchy::nodes() const
+{
+    return _nodes;
+}
+
+std::uint32_t
+TransformHierarchy::slot(const Node node) const
+{
+    if (not contains(node)) {
+        throw std::invalid_argument{"Invalid transform node"};
+    }
+    return _slots[node];
+}
+
+std::vector<std::uint32_t>
+TransformHierarchy::nodeDepths() const
+{
+    // Parent chains are walked only up to the first node with known depth, so every node is
+    // visited once
+    std::vector<std::uint32_t> depths(_parents.size(), kNoSlot);
+    std::vector<Node> chain;
+    for (std::uint32_t index = 0; index < _nodes.size(); ++index) {
+        if (_slots[_nodes[index]] != index) {
+            continue;
+        }
+        Node ancestor = _nodes[index];
+        while (ancestor != kInvalidNode and depths[ancestor] == kNoSlot) {
+            chain.push_back(ancestor);
+            ancestor = _parents[ancestor];
+        }
+        std::uint32_t depth = (ancestor == kInvalidNode) ? 0 : depths[ancestor] + 1;
+        for (; not chain.empty(); chain.pop_back()) {
+            depths[chain.back()] = depth++;
+        }
+    }
+    return depths;
+}
+
+void
+TransformHierarchy::appendSlot(const Node node, const glm::mat4& local)
+{
+    const Node parent = _parents[node];
+    const std::uint32_t nodeDepth = (parent == kInvalidNode) ? 0 : _depths[_slots[parent]] + 1;
+    const auto index = static_cast<std::uint32_t>(_nodes.size());
+    _slots[node] = index;
+    _nodes.push_back(node);
+    _parentSlots.push_back((parent == kInvalidNode) ? kNoSlot : _slots[parent]);
+    _depths.push_back(nodeDepth);
+    _locals.push_back(local);
+    _worlds.push_back(local);
+    _dirty.push_back(1);
+    _changed = true;
+
+    // Appending keeps the order while depth doesn't decrease
+    if (not _sorted) {
+        return;
+    }
+    const std::size_t levels = _levels.size() - 1;
+    if (nodeDepth + 1 == levels) {
+        _levels.back()++;
+    } else if (nodeDepth == levels) {
+        _levels.push_back(_nodes.size());
+    } else {
+        _sorted = false;
+    }
+}
+
+void
+TransformHierarchy::rebuild()
+{
+    // Depths are recomputed from parent links, slot order doesn't match them after reparenting
+    const auto depthByNode = nodeDepths();
+    std::vector<std::uint32_t> live;
+    live.reserve(_nodes.size());
+    for (std::uint32_t index = 0; index < _nodes.size(); ++index) {
+        const Node node = _nodes[index];
+        if (_slots[node] == index) {
+            live.push_back(index);
+            _depths[index] = depthByNode[node];
+        }
+    }
+
+    // Stable counting sort by depth
+    std::uint32_t maxDepth{};
+    for (const auto index : live) {
+        maxDepth = std::max(maxDepth, _depths[index]);
+    }
+    _levels.assign(live.empty() ? 1 : maxDepth + 2, 0);
+    for (const auto index : live) {
+        _levels[_depths[index] + 1]++;
+    }
+    for (std::size_t level = 1; level < _levels.size(); ++level) {
+        _levels[level] += _levels[level - 1];
+    }
+    std::vector<std::uint32_t> order(live.size());
+    {
+        std::vector<std::size_t> cursor{_levels.begin(), _levels.end() - 1};
+        for (const auto index : live) {
+            order[cursor[_depths[index]]++] = index;
+        }
+    }
+
+    std::vector<Node> nodes(order.size());
+    std::vector<std::uint32_t> depths(order.size());
+    std::vector<glm::mat4> locals(order.size());
+    std::vector<glm::mat4> worlds(order.size());
+    std::vector<std::uint8_t> dirty(order.size());
+    for (std::size_t index = 0; index < order.size(); ++index) {
+        const auto from = order[index];
+        nodes[index] = _nodes[from];
+        depths[index] = _depths[from];
+        locals[index] = _locals[from];
+        worlds[index] = _worlds[from];
+        dirty[index] = _dirty[from];
+        _slots[nodes[index]] = static_cast<std::uint32_t>(index);
+    }
+    std::vector<std::uint32_t> parentSlots(order.size());
+    for (std::size_t index = 0; index < order.size(); ++index) {
+        const Node parent = _parents[nodes[index]];
+        parentSlots[index] = (parent == kInvalidNode) ? kNoSlot : _slots[parent];
+    }
+
+    _nodes = std::move(nodes);
+    _depths = std::move(depths);
+    _locals = std::move(locals);
+    _worlds = std::move(worlds);
+    _dirty = std::move(dirty);
+    _parentSlots = std::move(parentSlots);
+    _sorted = true;
+}
+
+} // namespace glesy
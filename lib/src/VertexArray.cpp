@@ -0,0 +1,72 @@
+#include "glesy/VertexArray.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+namespace glesy {
+
+VertexArray::VertexArray()
+{
+    if (glGenVertexArrays(1, &_id); _id == 0) {
+        throw std::runtime_error("Failed to create vertex array");
+    }
+}
+
+VertexArray::VertexArray(VertexArray&& other) noexcept
+    : _id{std::exchange(other._id, 0)}
+{
+}
+
+VertexArray&
+VertexArray::operator=(VertexArray&& other) noexcept
+{
+    if (this != &other) {
+        glDeleteVertexArrays(1, &_id);
+        _id = std::exchange(other._id, 0);
+    }
+    return *this;
+}
+
+VertexArray::~VertexArray()
+{
+    glDeleteVertexArrays(1, &_id);
+}
+
+GLuint
+VertexArray::id() const
+{
+    return _id;
+}
+
+void
+VertexArray::bind() const
+{
+    glBindVertexArray(_id);
+}
+
+void
+VertexArray::unbind()
+{
+    glBindVertexArray(0);
+}
+
+void
+VertexArray::setVertexBuffer(const Buffer& buffer,
+                             const VertexFormat& format,
+                             const GLintptr baseOffset)
+{
+    glBindVertexArray(_id);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer.id());
+    applyVertexFormat(format, baseOffset);
+    glBindVertexArray(0);
+}
+
+void
+VertexArray::setIndexBuffer(const Buffer& buffer)
+{
+    glBindVertexArray(_id);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer.id());
+    glBindVertexArray(0);
+}
+
+} // namespace glesy
@@ -0,0 +1,26 @@
+#include "glesy/VertexFormat.hpp"
+
+namespace glesy {
+
+void
+applyVertexFormat(const VertexFormat& format, const GLintptr baseOffset)
+{
+    for (const auto& attr : format.attributes) {
+        const auto* pointer = reinterpret_cast<const void*>(baseOffset + attr.offset);
+        if (attr.integer) {
+            glVertexAttribIPointer(
+                attr.location, attr.components, attr.type, format.stride, pointer);
+        } else {
+            glVertexAttribPointer(attr.location,
+                                  attr.components,
+                                  attr.type,
+                                  attr.normalized ? GL_TRUE : GL_FALSE,
+                                  format.stride,
+                                  pointer);
+        }
+        glVertexAttribDivisor(attr.location, attr.divisor);
+        glEnableVertexAttribArray(attr.location);
+    }
+}
+
+} // namespace glesy
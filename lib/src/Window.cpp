@@ -0,0 +1,130 @@
+#include "glesy/Window.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <stdexcept>
+
+namespace glesy {
+
+namespace {
+
+void
+onError(const int code, const char* description)
+{
+    SPDLOG_ERROR("GLFW error <{}>: {}", code, description);
+}
+
+} // namespace
+
+Window::Window(const WindowSettings& settings)
+    : _settings{settings}
+{
+    glfwSetErrorCallback(onError);
+    if (glfwInit() == GLFW_FALSE) {
+        throw std::runtime_error{"Failed to initialize GLFW"};
+    }
+
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+    _handle = glfwCreateWindow(
+        _settings.width, _settings.height, _settings.title.data(), nullptr, nullptr);
+    if (_handle == nullptr) {
+        glfwTerminate();
+        throw std::runtime_error{"Failed to create GLFW window"};
+    }
+    glfwSetWindowUserPointer(_handle, this);
+    glfwSetFramebufferSizeCallback(_handle, onFramebufferResize);
+
+    int width{};
+    int height{};
+    glfwGetFramebufferSize(_handle, &width, &height);
+    _width = width;
+    _height = height;
+
+    glfwMakeContextCurrent(_handle);
+    if (const int version = gladLoadGL(glfwGetProcAddress); version > 0) {
+        SPDLOG_INFO("Initialized OpenGL {}.{} version",
+                    GLAD_VERSION_MAJOR(version),
+                    GLAD_VERSION_MINOR(version));
+    } else {
+        glfwDestroyWindow(_handle);
+        glfwTerminate();
+        throw std::runtime_error{"Failed to initialize OpenGL context"};
+    }
+    glfwSwapInterval(_settings.swapInterval);
+}
+
+Window::~Window()
+{
+    glfwDestroyWindow(_handle);
+    glfwTerminate();
+}
+
+GLFWwindow*
+Window::handle() const
+{
+    return _handle;
+}
+
+const WindowSettings&
+Window::settings() const
+{
+    return _settings;
+}
+
+bool
+Window::shouldClose() const
+{
+    return glfwWindowShouldClose(_handle) == GLFW_TRUE;
+}
+
+void
+Window::close()
+{
+    glfwSetWindowShouldClose(_handle, GLFW_TRUE);
+}
+
+void
+Window::makeCurrent()
+{
+    glfwMakeContextCurrent(_handle);
+}
+
+void
+Window::releaseCurrent()
+{
+    glfwMakeContextCurrent(nullptr);
+}
+
+void
+Window::swapBuffers()
+{
+    glfwSwapBuffers(_handle);
+}
+
+std::pair<int, int>
+Window::framebufferSize() const
+{
+    return {_width.load(std::memory_order_relaxed), _height.load(std::memory_order_relaxed)};
+}
+
+double
+Window::refreshRate()
+{
+    static constexpr double kDefaultRefreshRate{60.0};
+    GLFWmonitor* monitor = glfwGetPrimaryMonitor();
+    const GLFWvidmode* mode = (monitor != nullptr) ? glfwGetVideoMode(monitor) : nullptr;
+    return (mode != nullptr and mode->refreshRate > 0) ? mode->refreshRate : kDefaultRefreshRate;
+}
+
+void
+Window::onFramebufferResize(GLFWwindow* window, const int width, const int height)
+{
+    auto* self = static_cast<Window*>(glfwGetWindowUserPointer(window));
+    self->_width.store(width, std::memory_order_relaxed);
+    self->_height.store(height, std::memory_order_relaxed);
+}
+
+} // namespace glesy
@@ -1,16 +1,20 @@
 /**
- * Example 04: Demonstrates using uniforms to set color dynamically
+ * Example 04: Demonstrates using uniforms to set color dynamically.
+ *             Application runtime handles events on the main thread and renders
+ *             frame packets on the render thread.
  **/
 
 #include "glesy/Api.h"
+#include "glesy/Application.hpp"
 #include "glesy/Shader.hpp"
 
 #include <GLFW/glfw3.h>
 
 #include <spdlog/spdlog.h>
 
-static constexpr unsigned int kWidth{800};
-static constexpr unsigned int kHeight{600};
+#include <cmath>
+#include <optional>
+
 static constexpr int kVertexPosSize{3};
 static constexpr int kVertexPosIndex{0};
 
@@ -47,43 +51,27 @@ void main()
 }
 )glsl";
 
-static void
-onWindowResize(GLFWwindow* window, int width, int height);
-static void
-onWindowInput(GLFWwindow* window);
-
-int
-main()
-{
-    glfwInit();
-
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+/**
+ * Everything render thread needs to draw the frame
+ */
+struct Frame {
+    float greenValue{};
+};
 
-    GLFWwindow* window = glfwCreateWindow(kWidth, kHeight, "example04", nullptr, nullptr);
-    if (window == nullptr) {
-        SPDLOG_ERROR("Failed to create GLFW window");
-        glfwTerminate();
-        return EXIT_FAILURE;
-    }
-    glfwMakeContextCurrent(window);
-    glfwSetFramebufferSizeCallback(window, onWindowResize);
-
-    if (const int version = gladLoadGL(glfwGetProcAddress); version > 0) {
-        SPDLOG_INFO("Initialized OpenGL {}.{} version",
-                    GLAD_VERSION_MAJOR(version),
-                    GLAD_VERSION_MINOR(version));
-    } else {
-        SPDLOG_ERROR("Failed to initialize OpenGL context");
-        return EXIT_FAILURE;
+class Example04 final : public glesy::Application<Frame> {
+public:
+    Example04()
+        : Application{glesy::ApplicationSettings{.window = {.title = "example04"}}}
+    {
     }
 
+protected:
+    void
+    init() override
     {
-        const glesy::Shader shader(vShader, fShader);
-        int vertexColorLocation = glGetUniformLocation(shader.id(), "ourColor");
+        _shader.emplace(vShader, fShader);
+        _colorLocation = glGetUniformLocation(_shader->id(), "ourColor");
 
-        glViewport(0, 0, kWidth, kHeight);
         glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 #if 0
         // Enable wareframe mode
@@ -92,64 +80,80 @@ main()
         glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
 #endif
 
-        unsigned int VBO{}, VAO{}, EBO{};
-        glGenVertexArrays(1, &VAO);
-        glGenBuffers(1, &VBO);
-        glGenBuffers(1, &EBO);
-
-        {
-            glBindVertexArray(VAO);
-            glBindBuffer(GL_ARRAY_BUFFER, VBO);
-            glBufferData(GL_ARRAY_BUFFER, sizeof(kVertexData), kVertexData, GL_STATIC_DRAW);
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-            glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(kIndices), kIndices, GL_STATIC_DRAW);
-            glVertexAttribPointer(kVertexPosIndex,
-                                  kVertexPosSize,
-                                  GL_FLOAT,
-                                  GL_FALSE,
-                                  sizeof(GLfloat) * (kVertexPosSize),
-                                  (void*)0);
-            glEnableVertexAttribArray(kVertexPosIndex);
+        glGenVertexArrays(1, &_vao);
+        glGenBuffers(1, &_vbo);
+        glGenBuffers(1, &_ebo);
+
+        glBindVertexArray(_vao);
+        glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(kVertexData), kVertexData, GL_STATIC_DRAW);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(kIndices), kIndices, GL_STATIC_DRAW);
+        glVertexAttribPointer(kVertexPosIndex,
+                              kVertexPosSize,
+                              GL_FLOAT,
+                              GL_FALSE,
+                              sizeof(GLfloat) * (kVertexPosSize),
+                              (void*)0);
+        glEnableVertexAttribArray(kVertexPosIndex);
+        glBindVertexArray(0);
+    }
+
+    void
+    update(Frame& frame, const glesy::FrameTime& time) override
+    {
+        if (glfwGetKey(window().handle(), GLFW_KEY_ESCAPE) == GLFW_PRESS) {
+            window().close();
         }
 
-        while (not glfwWindowShouldClose(window)) {
-            onWindowInput(window);
+        // Color follows interpolated simulation time
+        const double seconds = time.time + time.alpha * time.step;
+        frame.greenValue = (std::sin(static_cast<float>(seconds)) / 2.0f) + 0.5f;
+    }
 
-            // Clear the color buffer
-            glClear(GL_COLOR_BUFFER_BIT);
+    void
+    render(const Frame& frame) override
+    {
+        // Clear the color buffer
+        glClear(GL_COLOR_BUFFER_BIT);
 
-            // Activate shader program
-            shader.use();
+        // Activate shader program
+        _shader->use();
 
-            // Update color uniform value
-            const float greenValue = (std::sin(static_cast<float>(glfwGetTime())) / 2.0f) + 0.5f;
-            glUniform4f(vertexColorLocation, 0.0f, greenValue, 0.0f, 1.0f);
+        // Update color uniform value
+        glUniform4f(_colorLocation, 0.0f, frame.greenValue, 0.0f, 1.0f);
 
-            // Bind array arrays object (state) and draw
-            glBindVertexArray(VAO);
-            glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-            glBindVertexArray(0);
+        // Bind array arrays object (state) and draw
+        glBindVertexArray(_vao);
+        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+        glBindVertexArray(0);
+    }
 
-            // Swap back and front buffers
-            glfwSwapBuffers(window);
-            glfwPollEvents();
-        }
+    void
+    shutdown() override
+    {
+        glDeleteVertexArrays(1, &_vao);
+        glDeleteBuffers(1, &_vbo);
+        glDeleteBuffers(1, &_ebo);
+        _shader.reset();
     }
 
-    glfwTerminate();
-    return EXIT_SUCCESS;
-}
+private:
+    std::optional<glesy::Shader> _shader;
+    GLint _colorLocation{-1};
+    GLuint _vao{};
+    GLuint _vbo{};
+    GLuint _ebo{};
+};
 
-static void
-onWindowInput(GLFWwindow* window)
+int
+main()
 {
-    if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS) {
-        glfwSetWindowShouldClose(window, true);
+    try {
+        Example04 application;
+        return application.run();
+    } catch (const std::exception& error) {
+        SPDLOG_ERROR("Application failed: {}", error.what());
+        return EXIT_FAILURE;
     }
 }
-
-static void
-onWindowResize(GLFWwindow* /*window*/, const int width, const int height)
-{
-    glViewport(0, 0, width, height);
-}
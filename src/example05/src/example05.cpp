@@ -5,8 +5,10 @@
  **/
 
 #include "glesy/Api.h"
+#include "glesy/Buffer.hpp"
 #include "glesy/Shader.hpp"
 #include "glesy/Texture.hpp"
+#include "glesy/VertexLayout.hpp"
 
 #include <GLFW/glfw3.h>
 
@@ -14,20 +16,32 @@
 
 static constexpr unsigned int kWidth{800};
 static constexpr unsigned int kHeight{600};
-static constexpr int kVertexSize{8};
-static constexpr int kVertexPosIndex{0};
-
-static float kVertices[] = {
-    // positions         // colors           // texture coords
-    0.5f,  0.5f, 0.0f,   1.0f, 0.0f, 0.0f,   1.0f, 1.0f, // top right
-    0.5f, -0.5f, 0.0f,   0.0f, 1.0f, 0.0f,   1.0f, 0.0f, // bottom right
-   -0.5f, -0.5f, 0.0f,   0.0f, 0.0f, 1.0f,   0.0f, 0.0f, // bottom left
-   -0.5f,  0.5f, 0.0f,   1.0f, 1.0f, 0.0f,   0.0f, 1.0f  // top left
+
+struct Vertex {
+    GLfloat position[3];
+    GLfloat color[3];
+    GLfloat texCoord[2];
+};
+
+using VertexLayout = glesy::VertexLayout<glesy::FloatAttr<0, 3>, // aPosition
+                                         glesy::FloatAttr<1, 3>, // aColor
+                                         glesy::FloatAttr<2, 2>  // aTexCoord
+                                         >;
+static_assert(sizeof(Vertex) == VertexLayout::kStride);
+
+// clang-format off
+static constexpr Vertex kVertices[] = {
+    // positions           // colors            // texture coords
+    {{0.5f,  0.5f, 0.0f},  {1.0f, 0.0f, 0.0f},  {1.0f, 1.0f}}, // top right
+    {{0.5f, -0.5f, 0.0f},  {0.0f, 1.0f, 0.0f},  {1.0f, 0.0f}}, // bottom right
+    {{-0.5f, -0.5f, 0.0f}, {0.0f, 0.0f, 1.0f},  {0.0f, 0.0f}}, // bottom left
+    {{-0.5f,  0.5f, 0.0f}, {1.0f, 1.0f, 0.0f},  {0.0f, 1.0f}}  // top left
 };
-static unsigned int kIndices[] = {
+static constexpr GLuint kIndices[] = {
     0, 1, 3, // first triangle
     1, 2, 3  // second triangle
 };
+// clang-format on
 
 static auto vShader = R"glsl(
 #version 330 core
@@ -121,36 +135,10 @@ main()
                          texture.data.data());
         }
 
-        unsigned int VBO{}, VAO{}, EBO{};
-        glGenVertexArrays(1, &VAO);
-        glGenBuffers(1, &VBO);
-        glGenBuffers(1, &EBO);
-        glBindVertexArray(VAO);
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(kVertices), kVertices, GL_STATIC_DRAW);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(kIndices), kIndices, GL_STATIC_DRAW);
-        glVertexAttribPointer(0,
-                              3,
-                              GL_FLOAT,
-                              GL_FALSE,
-                              8 * sizeof(GLfloat),
-                              (void*)0);
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(1,
-                              3,
-                              GL_FLOAT,
-                              GL_FALSE,
-                              8 * sizeof(GLfloat),
-                              (void*)(3 * sizeof(float)));
-        glEnableVertexAttribArray(1);
-        glVertexAttribPointer(2,
-                              2,
-                              GL_FLOAT,
-                              GL_FALSE,
-                              8 * sizeof(GLfloat),
-                              (void*)(6 * sizeof(float)));
-        glEnableVertexAttribArray(2);
+        const glesy::Buffer vbo{GL_ARRAY_BUFFER, std::span{kVertices}};
+        const glesy::Buffer ebo{GL_ELEMENT_ARRAY_BUFFER, std::span{kIndices}};
+        // Vertex layout is validated against shader inputs once here
+        const GLuint vao = shader.vertexArray(vbo, &ebo, VertexLayout::format());
 
         while (not glfwWindowShouldClose(window)) {
             onWindowInput(window);
@@ -166,8 +154,9 @@ main()
             shader.use();
 
             // Draw
-            glBindVertexArray(VAO);
-            glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+            glBindVertexArray(vao);
+            glDrawElements(
+                GL_TRIANGLES, static_cast<GLsizei>(std::size(kIndices)), GL_UNSIGNED_INT, nullptr);
 
             // Swap back and front buffers
             glfwSwapBuffers(window);